@@ -1137,6 +1137,7 @@
                                                         //    (FTM_FS / FTM_MIN_SHAPE_FREQ) for ZVD, MZV.
                                                         //    3/2 * (FTM_FS / FTM_MIN_SHAPE_FREQ) for 2HEI.
                                                         //    2 * (FTM_FS / FTM_MIN_SHAPE_FREQ) for 3HEI.
+                                                        // Lower frequencies are shaped as the lowest that fits.
   #define FTM_STEPS_PER_UNIT_TIME    20                 // Interpolated stepper commands per unit time.
                                                         // Calculate as (FTM_STEPPER_FS / FTM_FS).
   #define FTM_CTS_COMPARE_VAL        10                 // Comparison value used in interpolation algorithm.
@@ -1148,6 +1149,9 @@
   // This value may be configured to adjust duration to consume the command buffer.
   // Try increasing this value if stepper motion is not smooth.
   #define FTM_STEPPERCMD_BUFF_SIZE 1000                 // Size of the stepper command buffers.
+  // Commands to queue before the stepper starts, or restarts after running dry. Set higher if a busy
+  // display or SD card makes motion stutter. M493 reports underruns and buffer levels.
+  #define FTM_STEPPERCMD_PREFILL    100                 // Pre-fill watermark for the stepper command buffer.
 
   //#define FT_MOTION_MENU                              // Provide a MarlinUI menu to set M493 parameters.
 #endif
@@ -1367,6 +1371,14 @@
 #define MULTISTEPPING_LIMIT   16  //: [1, 2, 4, 8, 16, 32, 64, 128]
 #define OLD_ADAPTIVE_MULTISTEPPING 1
 
+/**
+ * Stepper ISR Statistics
+ * Measure the time spent in each phase of the Stepper ISR and keep a histogram
+ * per phase. Shows how close the ISR runs to its limit before steps are lost.
+ * M961 reports, M961 R resets, and M961 S<seconds> sets an auto-report interval.
+ */
+//#define STEPPER_ISR_STATS
+
 /**
  * Adaptive Step Smoothing increases the resolution of multi-axis moves, particularly at step frequencies
  * below 1kHz (for AVR) or 10kHz (for ARM), where aliasing between axes in multi-axis moves causes audible
@@ -1375,6 +1387,20 @@
  */
 #define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Step Compiler
+ * Run the Bresenham line tracer for the next few blocks while the main loop is
+ * idle and store the steppers to step on each step event. The Stepper ISR then
+ * reads one table entry per step event instead of tracing every axis. Blocks
+ * with more step events than a table holds are traced live past the end.
+ */
+//#define STEP_COMPILER
+#if ENABLED(STEP_COMPILER)
+  #define STEP_COMPILER_BLOCKS    4 // Tables for this many blocks ahead of the Stepper. Power of 2.
+  #define STEP_COMPILER_EVENTS  512 // Step events per table. 1 byte each (2 with more than 8 axes).
+  //#define STEP_COMPILER_CHECK     // Also trace every event live and count the table entries that differ. For testing.
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1759,6 +1785,18 @@
                                       // Note: Only affects SCROLL_LONG_FILENAMES with SDSORT_CACHE_NAMES but not SDSORT_DYNAMIC_RAM.
   #endif
 
+  /**
+   * Note where each item of the current folder is when it's counted, so
+   * menus and host/TFT file lists read only the items they show instead of
+   * scanning the folder from the start for each one. Speeds up paging in
+   * large folders and SDCARD_SORT_ALPHA pre-sorting. The index is rebuilt
+   * when the folder changes. Uses 2 bytes of SRAM per item.
+   */
+  //#define SDCARD_DIR_INDEX
+  #if ENABLED(SDCARD_DIR_INDEX)
+    #define SDCARD_DIR_INDEX_MAX 128    // (16-1024) Items to index. Later items are found from the last one.
+  #endif
+
   // Allow international symbols in long filenames. To display correctly, the
   // LCD's font must contain the characters. Check your selected LCD language.
   //#define UTF_FILENAME_SUPPORT
@@ -1857,6 +1895,71 @@
   #if ENABLED(BINARY_FILE_TRANSFER)
     // Include extra facilities (e.g., 'M20 F') supporting firmware upload via BINARY_FILE_TRANSFER
     #define CUSTOM_FIRMWARE_UPLOAD
+
+    // Also accept packed G0-G3 moves over the binary protocol, without text parsing.
+    // See buildroot/share/scripts/MarlinBinaryProtocol.py for the host side.
+    //#define BINARY_MOTION_STREAM
+  #endif
+
+  /**
+   * Print heatshrink-compressed G-code files, decompressing them as they are read.
+   * Compressed jobs take about a third of the space and of the SD reads per mm.
+   * Files must have the '.hs' extension (e.g., 'part.gcode.hs') and be compressed
+   * with a window of 8 bits and a lookahead of 4 bits:
+   *   heatshrink -e -w 8 -l 4 part.gcode part.gcode.hs
+   * M26, M808 and power-loss resume use positions in the decompressed G-code,
+   * so they have to decompress the file up to that point. M27 reports progress
+   * through the compressed file. Requires about 360 bytes of SRAM.
+   */
+  //#define SDCARD_COMPRESSED_GCODE
+
+  /**
+   * Read ahead in the file being printed, with one multiple-block command for
+   * several blocks instead of one command per 512-byte block. The buffer is
+   * refilled while the machine is idle, so reading G-code rarely waits for
+   * the card. Uses SDCARD_READ_AHEAD_BLOCKS * 512 bytes of SRAM.
+   */
+  //#define SDCARD_READ_AHEAD
+  #if ENABLED(SDCARD_READ_AHEAD)
+    #define SDCARD_READ_AHEAD_BLOCKS 8  // (2-16) Blocks to buffer
+  #endif
+
+  /**
+   * Cache several SD blocks instead of one, with separate parts for FAT and
+   * directory blocks and for file data. Reading a file doesn't evict the FAT
+   * block for its cluster chain, and power-loss recovery saves don't evict
+   * the print file's blocks. Uses 528 bytes of SRAM per block.
+   * M963 reports the hits and misses for each part. M963 R resets them.
+   */
+  //#define SDCARD_BLOCK_CACHE
+  #if ENABLED(SDCARD_BLOCK_CACHE)
+    #define SDCARD_CACHE_FAT_BLOCKS  2  // (1-8) FAT and directory blocks
+    #define SDCARD_CACHE_DATA_BLOCKS 2  // (1-8) File data blocks
+  #endif
+
+  /**
+   * Map the clusters of a file when it's opened for printing, as a list of
+   * contiguous runs. Most files are in one run. Reads and seeks (M26, M808,
+   * power-loss resume) then find any position without reading the FAT.
+   * Uses 8 bytes of SRAM per run. A file in more runs than this is mapped
+   * as far as they go, and the FAT is followed for the rest.
+   */
+  //#define SDCARD_FILE_EXTENTS
+  #if ENABLED(SDCARD_FILE_EXTENTS)
+    #define SDCARD_FILE_EXTENTS_MAX 8   // (1-32) Runs to map
+  #endif
+
+  /**
+   * Buffer the file being saved (M28, binary file transfer) and write it
+   * out while the machine is idle, several blocks at a time with one
+   * pre-erased multiple-block command instead of one command per 512-byte
+   * block. Uploads wait for the card only when the buffer is full.
+   * The rest is written when the file is closed (M29).
+   * Uses SDCARD_WRITE_BEHIND_BLOCKS * 512 bytes of SRAM.
+   */
+  //#define SDCARD_WRITE_BEHIND
+  #if ENABLED(SDCARD_WRITE_BEHIND)
+    #define SDCARD_WRITE_BEHIND_BLOCKS 8  // (2-16) Blocks to buffer
   #endif
 
   /**
@@ -2535,12 +2638,74 @@
   #define BLOCK_BUFFER_SIZE 64
 #endif
 
+/**
+ * Incremental Planner
+ * Stop recalculating the plan at the first block whose entry speed is
+ * unchanged, instead of revisiting every block in the buffer. This keeps
+ * the cost of each new block about the same for any BLOCK_BUFFER_SIZE,
+ * and allows a BLOCK_BUFFER_SIZE of up to 128.
+ */
+//#define INCREMENTAL_PLANNER
+
+/**
+ * Adaptive Look-Ahead
+ * Limit the planner by the distance and time of the queued moves instead
+ * of only by BLOCK_BUFFER_SIZE. Moves are accepted until the queue covers
+ * both LOOKAHEAD_MM and LOOKAHEAD_MS, so short segments on fine curves can
+ * fill a large buffer while long moves keep only a few blocks queued, and
+ * the printer still responds quickly to pause and cancel.
+ * Use with a large BLOCK_BUFFER_SIZE (and INCREMENTAL_PLANNER for 128).
+ */
+//#define ADAPTIVE_LOOKAHEAD
+#if ENABLED(ADAPTIVE_LOOKAHEAD)
+  #define LOOKAHEAD_MM          50  // (mm) Queue moves until they cover this distance...
+  #define LOOKAHEAD_MS         500  // (ms) ...and this much time at their nominal speed
+  #define LOOKAHEAD_MIN_BLOCKS   4  // Always queue at least this many blocks for junction planning
+#endif
+
+/**
+ * Segment Merging
+ * Merge runs of nearly collinear G0/G1 moves into one planner block.
+ * Slicers often split straight lines into many short moves, each of which
+ * costs a block and a full planner pass. Moves are merged only when every
+ * joint lies within the chord tolerance of the merged line and the feedrate
+ * and E/XYZ ratio don't change. Use M962 to report the merge ratio.
+ */
+//#define SEGMENT_MERGE
+#if ENABLED(SEGMENT_MERGE)
+  #define SEGMENT_MERGE_TOLERANCE   0.01  // (mm) Largest distance from a joint to the merged line. M962 T to change.
+  #define SEGMENT_MERGE_E_TOLERANCE    1  // (%) Largest change in the E/XYZ ratio
+  #define SEGMENT_MERGE_MAX           16  // Most moves merged into one block
+#endif
+
+/**
+ * Fixed-Point Trapezoids
+ * Calculate the acceleration and deceleration steps of each block (and the
+ * S-Curve timing) with integer math instead of float. Much faster on MCUs
+ * without an FPU. The results are exact, so they can differ from the float
+ * version by a step. Use PLANNER_BENCHMARK with M960 T to compare the two.
+ */
+//#define FIXED_POINT_TRAPEZOIDS
+
 // @section serial
 
 // The ASCII buffer for serial input
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 32
 
+/**
+ * Command Arena
+ * Assemble each line in place in a byte arena and queue it as a view,
+ * instead of copying it into one of BUFSIZE fixed MAX_CMD_SIZE slots.
+ * A queued command then takes only as much RAM as its text. Each serial
+ * port has its own arena, and SD and internal commands share another.
+ * BUFSIZE still limits the number of queued commands.
+ */
+//#define COMMAND_ARENA
+#if ENABLED(COMMAND_ARENA)
+  #define COMMAND_ARENA_SIZE 1024 // (bytes) Size of each arena. At least 2 * MAX_CMD_SIZE.
+#endif
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of flash (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -2550,6 +2715,20 @@
 // :[0, 2, 4, 8, 16, 32, 64, 128, 256]
 #define TX_BUFFER_SIZE 128
 
+/**
+ * Serial TX Queue
+ * Queue the output for each host serial port and pass it on only as fast
+ * as the port takes it, so long reports don't hold up the main loop.
+ *  - Auto-reports (M155, M154, M27 S) wait while older output is queued,
+ *    then send the latest values instead of piling up.
+ *  - M503 and mesh reports (M420 V) are written a piece at a time,
+ *    running idle() while the ports catch up.
+ */
+//#define SERIAL_TX_QUEUE
+#if ENABLED(SERIAL_TX_QUEUE)
+  #define SERIAL_TX_QUEUE_SIZE 512  // (bytes) Per port. A power of 2.
+#endif
+
 // Host Receive Buffer Size
 // Without XON/XOFF flow control (see SERIAL_XON_XOFF below) 32 bytes should be enough.
 // To use flow control, set this buffer size to at least 1024 bytes.
@@ -2572,6 +2751,15 @@
   //#define SERIAL_STATS_DROPPED_RX
 #endif
 
+/**
+ * Serial DMA (HC32F46x only)
+ * Move serial data with DMA instead of taking an interrupt for every byte,
+ * so the UARTs don't compete with the Stepper ISR at high baud rates.
+ * RX_BUFFER_SIZE must be from 32 to 32768 and TX_BUFFER_SIZE at least 16.
+ * M111 reports buffer overruns and dropped bytes on the first port.
+ */
+//#define SERIAL_DMA
+
 // Monitor RX buffer usage
 // Dump an error to the serial port if the serial receive buffer overflows.
 // If you see these errors, increase the RX_BUFFER_SIZE value.
@@ -2617,6 +2805,22 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 #define ADVANCED_OK
 
+/**
+ * Credit-based flow control lets the host keep several lines in flight
+ * instead of waiting for each "ok". Every "ok" adds W<line>, the last line
+ * number the host may send for now, so the round trip no longer limits
+ * short-segment jobs. Only the port's own lines count against the command
+ * queue, so W never goes down while SD or injected commands share it; lines
+ * sent ahead then wait in the RX buffer. With COMMAND_ARENA the host gets
+ * no more lines in flight than the arena and RX buffer hold at MAX_CMD_SIZE
+ * each. Lines still get one "ok" each, in order. After a bad line,
+ * everything else already in transit is dropped without a second "Resend:"
+ * until the requested line (or M110) arrives, so the host resends once
+ * from that line.
+ * Requires ADVANCED_OK. Reported by M115 as Cap:CREDIT_FLOW_CONTROL.
+ */
+//#define CREDIT_FLOW_CONTROL
+
 // Printrun may have trouble receiving long strings all at once.
 // This option inserts short delays between lines of serial output.
 #define SERIAL_OVERRUN_PROTECTION
@@ -3827,8 +4031,26 @@
  */
 #define FASTER_GCODE_PARSER
 
+/**
+ * Parse G-code numbers with a small decimal parser instead of strtof.
+ * G-code numbers have no exponent, so this is much faster and smaller
+ * than strtof on most MCUs. Values match strtof to 7 significant digits.
+ */
+//#define FAST_NUMBER_PARSER
+
 #if ENABLED(FASTER_GCODE_PARSER)
   //#define GCODE_QUOTED_STRINGS  // Support for quoted string parameters
+
+  /**
+   * Parse commands when they are queued instead of when they run.
+   * Numeric parameters are converted once and kept in the queue with the
+   * command, so handlers like G1 get their values without calling strtof.
+   * Uses 40 bytes + 4 bytes per value of SRAM for each command in BUFSIZE.
+   */
+  //#define PRETOKENIZED_GCODE
+  #if ENABLED(PRETOKENIZED_GCODE)
+    #define PRETOKENIZED_GCODE_VALUES 8 // Numeric parameters to convert per command
+  #endif
 #endif
 
 // Support for MeatPack G-code compression (https://github.com/scottmudge/OctoPrint-MeatPack)
@@ -4389,6 +4611,14 @@
 // Enable Tests that will run at startup and produce a report
 //#define MARLIN_TEST_BUILD
 
+/**
+ * Planner Benchmark
+ * Time the planner stages and report blocks/sec and latency histograms with M960.
+ * Blocks are retired by the planner instead of being stepped, so this is only
+ * useful on native builds. See 'linux_native_benchmark' in ini/native.ini.
+ */
+//#define PLANNER_BENCHMARK
+
 // Enable Marlin dev mode which adds some special commands
 //#define MARLIN_DEV_MODE
 
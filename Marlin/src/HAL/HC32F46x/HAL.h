@@ -122,6 +122,8 @@ extern "C" void usart_rx_irq_hook(uint8_t ch, uint8_t usart);
 // Misc. Defines
 //
 #define STM32_FLASH_SIZE 256
+#define HAL_SDIO_READ_BLOCKS   // This HAL can read multiple SDIO blocks in one transfer
+#define HAL_SDIO_WRITE_BLOCKS  // This HAL can write multiple SDIO blocks in one transfer
 #define square(x) ((x) * (x))
 
 #ifndef strncpy_P
@@ -89,7 +89,18 @@ void MarlinHAL::isr_off() { __disable_irq(); }
 
 void MarlinHAL::delay_ms(const int ms) { delay(ms); }
 
-void MarlinHAL::idletask() { MarlinHAL::watchdog_refresh(); }
+void MarlinHAL::idletask() {
+  MarlinHAL::watchdog_refresh();
+
+  #if ENABLED(SERIAL_DMA)
+    // Keep the DMA transmitters going when nothing else is written,
+    // and feed the emergency parser when nothing reads the port
+    MSerial2.task();
+    MSerial2.rx_update();
+    MSerial4.task();
+    MSerial4.rx_update();
+  #endif
+}
 
 uint8_t MarlinHAL::get_reset_source() {
   // query reset cause
@@ -21,8 +21,8 @@
  */
 
 #ifdef TARGET_HC32F46x
-  #include "MarlinSerial.h"
   #include "../../inc/MarlinConfig.h"
+  #include "MarlinSerial.h"
   #include <drivers/usart/usart.h>
 
 /**
@@ -43,6 +43,201 @@ constexpr bool serial_handles_emergency(int port) {
       ;
 }
 
+#if ENABLED(SERIAL_DMA)
+
+#define _EVT_USART(n, E) EVT_USART##n##_##E
+
+#define RX_POS(N) ((N) & ((RX_BUFFER_SIZE) - 1))
+
+void MarlinSerial::dma_begin() {
+  M4_USART_TypeDef * const usart = c_dev()->peripheral.register_base;
+
+  // Every byte goes through the DMA, so keep the per-byte handlers of the core out of it
+  NVIC_DisableIRQ(c_dev()->interrupts.rx_data_available.interrupt_number);
+  NVIC_DisableIRQ(c_dev()->interrupts.tx_buffer_empty.interrupt_number);
+  NVIC_DisableIRQ(c_dev()->interrupts.tx_complete.interrupt_number);
+
+  PWC_Fcg0PeriphClockCmd((dma == M4_DMA1 ? PWC_FCG0_PERIPH_DMA1 : PWC_FCG0_PERIPH_DMA2) | PWC_FCG0_PERIPH_AOS, Enable);
+  DMA_Cmd(dma, Enable);
+
+  rx_laps = rx_read = rx_parsed = 0;
+  rx_dropped = rx_overruns = 0;
+  tx_head = tx_tail = tx_count = tx_chunk = 0;
+
+  stc_dma_config_t cfg;
+
+  // RX: From the receive data register (the upper half of DR) into the buffer, one lap at a time.
+  // rx_lap_irq() counts each lap and starts the next, so the bytes written are always known.
+  MEM_ZERO_STRUCT(cfg);
+  cfg.u16BlockSize = 1;
+  cfg.u16TransferCnt = RX_BUFFER_SIZE;
+  cfg.u32SrcAddr = uint32_t(&usart->DR) + 2;
+  cfg.u32DesAddr = uint32_t(rx_buffer);
+  cfg.stcDmaChCfg.enSrcInc = AddressFix;
+  cfg.stcDmaChCfg.enDesInc = AddressIncrease;
+  cfg.stcDmaChCfg.enTrnWidth = Dma8Bit;
+  cfg.stcDmaChCfg.enIntEn = Enable;
+  DMA_InitChannel(dma, rx_ch, &cfg);
+  DMA_SetTriggerSrc(dma, rx_ch, rx_event);
+
+  stc_irq_regi_conf_t irq;
+  irq.enIntSrc = rx_lap_src;
+  irq.pfnCallback = rx_lap_cb;
+  irqn_aa_get(irq.enIRQn, "serial dma");
+  enIrqRegistration(&irq);
+  #ifdef UART_IRQ_PRIO
+    NVIC_SetPriority(irq.enIRQn, UART_IRQ_PRIO);
+  #else
+    NVIC_SetPriority(irq.enIRQn, DDL_IRQ_PRIORITY_DEFAULT);
+  #endif
+  NVIC_ClearPendingIRQ(irq.enIRQn);
+  NVIC_EnableIRQ(irq.enIRQn);
+
+  DMA_ClearIrqFlag(dma, rx_ch, TrnCpltIrq);
+  DMA_EnableIrq(dma, rx_ch, TrnCpltIrq);
+  DMA_ChannelCmd(dma, rx_ch, Enable);
+
+  // TX: From the output ring into the transmit data register. task() sets the source and count.
+  MEM_ZERO_STRUCT(cfg);
+  cfg.u16BlockSize = 1;
+  cfg.u32DesAddr = uint32_t(&usart->DR);
+  cfg.stcDmaChCfg.enSrcInc = AddressIncrease;
+  cfg.stcDmaChCfg.enDesInc = AddressFix;
+  cfg.stcDmaChCfg.enTrnWidth = Dma8Bit;
+  cfg.stcDmaChCfg.enIntEn = Disable;
+  DMA_InitChannel(dma, tx_ch, &cfg);
+  DMA_SetTriggerSrc(dma, tx_ch, tx_event);
+}
+
+// The RX channel filled the buffer. Count the lap and start the next one from the top.
+void MarlinSerial::rx_lap_irq() {
+  DMA_ClearIrqFlag(dma, rx_ch, TrnCpltIrq);
+  rx_laps++;
+
+  // The channel stops at the end of a lap, so a byte received since then has no
+  // transfer to take it. Take it here and start the lap after it.
+  M4_USART_TypeDef * const usart = c_dev()->peripheral.register_base;
+  uint16_t n = 0;
+  if (USART_GetStatus(usart, UsartRxNoEmpty) == Set) rx_buffer[n++] = USART_RecData(usart);
+
+  DMA_SetDesAddress(dma, rx_ch, uint32_t(&rx_buffer[n]));
+  DMA_SetTransferCnt(dma, rx_ch, RX_BUFFER_SIZE - n);
+  DMA_ChannelCmd(dma, rx_ch, Enable);
+}
+
+// Total bytes received since begin(), wrapping at 2^32
+uint32_t MarlinSerial::rx_written() {
+  uint32_t laps, pos;
+  do {
+    laps = rx_laps;
+    pos = DMA_GetDesAddr(dma, rx_ch) - uint32_t(rx_buffer);
+  } while (laps != rx_laps);
+  return laps * (RX_BUFFER_SIZE) + pos;
+}
+
+void MarlinSerial::rx_update() {
+  // Right at the end of a lap the address may be back at the top before the lap is counted.
+  // That reads as fewer bytes than last time, so just wait for the IRQ.
+  const uint32_t written = rx_written();
+  if (int32_t(written - rx_parsed) <= 0) return;
+
+  // More unread bytes than the buffer holds means the DMA lapped the reader.
+  // The whole buffer is suspect, so drop it and carry on from the newest byte.
+  const uint32_t pending = written - rx_read;
+  if (pending > RX_BUFFER_SIZE) {
+    rx_overruns++;
+    rx_dropped += pending;
+    rx_read = rx_parsed = written;
+    return;
+  }
+
+  #if ENABLED(EMERGENCY_PARSER)
+    // Parse the new bytes now, since there's no RX interrupt to do it
+    MSerialT * const ser = static_cast<MSerialT*>(this);
+    if (ser->emergency_parser_enabled())
+      for (; rx_parsed != written; ++rx_parsed)
+        emergency_parser.update(ser->emergency_state, rx_buffer[RX_POS(rx_parsed)]);
+  #endif
+  rx_parsed = written;
+}
+
+int MarlinSerial::available() {
+  rx_update();
+  return rx_parsed - rx_read;
+}
+
+int MarlinSerial::peek() {
+  return available() ? rx_buffer[RX_POS(rx_read)] : -1;
+}
+
+int MarlinSerial::read() {
+  if (!available()) return -1;
+  return rx_buffer[RX_POS(rx_read++)];
+}
+
+size_t MarlinSerial::write(uint8_t c) {
+  while (tx_count >= TX_BUFFER_SIZE) task();  // Wait for room, like the core does
+  tx_buffer[tx_head] = c;
+  tx_head = (tx_head + 1) % (TX_BUFFER_SIZE);
+  tx_count++;
+  task();
+  return 1;
+}
+
+void MarlinSerial::flush() {
+  while (tx_count) task();
+  M4_USART_TypeDef * const usart = c_dev()->peripheral.register_base;
+  while (USART_GetStatus(usart, UsartTxComplete) == Reset) { /* nada */ }
+}
+
+void MarlinSerial::task() {
+  // Free whatever the DMA has sent so far
+  if (tx_chunk) {
+    const uint16_t left = DMA_GetTransferCnt(dma, tx_ch), sent = tx_chunk - left;
+    tx_tail = (tx_tail + sent) % (TX_BUFFER_SIZE);
+    tx_count -= sent;
+    tx_chunk = left;
+    if (left) return;
+  }
+  if (!tx_count) return;
+
+  // Wait for the last byte of the previous chunk to leave the data register
+  M4_USART_TypeDef * const usart = c_dev()->peripheral.register_base;
+  if (USART_GetStatus(usart, UsartTxEmpty) == Reset) return;
+
+  // Send up to the end of the ring. The rest goes in the next chunk.
+  // The first byte is written here, and its TX-empty event starts the DMA on the rest.
+  const uint16_t len = _MIN(tx_count, (TX_BUFFER_SIZE) - tx_tail);
+  const uint8_t c = tx_buffer[tx_tail];
+  tx_tail = (tx_tail + 1) % (TX_BUFFER_SIZE);
+  tx_count--;
+  tx_chunk = len - 1;
+  if (tx_chunk) {
+    DMA_SetSrcAddress(dma, tx_ch, uint32_t(&tx_buffer[tx_tail]));
+    DMA_SetTransferCnt(dma, tx_ch, tx_chunk);
+    DMA_ChannelCmd(dma, tx_ch, Enable);
+  }
+  USART_SendData(usart, c);
+}
+
+  //
+  // define serial ports
+  // The SDIO driver uses DMA1, so the serial ports take the DMA2 channels
+  //
+  #define DEFINE_HWSERIAL_MARLIN(name, n, rx_ch, tx_ch)                        \
+    static void name##_rx_lap();                                               \
+    MSerialT name(serial_handles_emergency(n), &USART##n##_config,             \
+                  BOARD_USART##n##_TX_PIN, BOARD_USART##n##_RX_PIN,            \
+                  M4_DMA2, DmaCh##rx_ch, DmaCh##tx_ch,                         \
+                  _EVT_USART(n, RI), _EVT_USART(n, TI),                        \
+                  INT_DMA2_TC##rx_ch, name##_rx_lap);                          \
+    static void name##_rx_lap() { name.rx_lap_irq(); }
+
+DEFINE_HWSERIAL_MARLIN(MSerial2, 2, 0, 1);
+DEFINE_HWSERIAL_MARLIN(MSerial4, 4, 2, 3);
+
+#else
+
   //
   // define serial ports
   //
@@ -53,6 +248,8 @@ constexpr bool serial_handles_emergency(int port) {
 DEFINE_HWSERIAL_MARLIN(MSerial2, 2);
 DEFINE_HWSERIAL_MARLIN(MSerial4, 4);
 
+#endif // SERIAL_DMA
+
 //
 // serial port assertions
 //
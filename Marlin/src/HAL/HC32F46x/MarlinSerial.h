@@ -24,9 +24,79 @@
 #include "../../core/serial_hook.h"
 #include "HardwareSerial.h"
 
+#if ENABLED(SERIAL_DMA)
+  #include <hc32_ddl.h>
+  #include <drivers/irqn/irqn.h>
+#endif
+
 // optionally set uart IRQ priority to reduce overflow errors
 // #define UART_IRQ_PRIO 1
 
+#if ENABLED(SERIAL_DMA)
+
+/**
+ * DMA-driven serial port. RX runs into a circular buffer, a lap at a time, and
+ * TX sends the output ring in contiguous chunks, so neither direction takes
+ * an interrupt per byte. The RX position is read back from the DMA channel
+ * whenever the port is polled, which stands in for idle-line detection.
+ * An interrupt at the end of each lap of the RX buffer keeps count of the
+ * bytes received, so a reader that falls a whole buffer behind is caught.
+ */
+struct MarlinSerial : public HardwareSerial {
+  MarlinSerial(struct usart_config_t *config, uint8_t tx_pin, uint8_t rx_pin,
+               M4_DMA_TypeDef *dma, uint8_t rx_ch, uint8_t tx_ch,
+               en_event_src_t rx_event, en_event_src_t tx_event,
+               en_int_src_t rx_lap_src, func_ptr_t rx_lap_cb)
+      : HardwareSerial(config, tx_pin, rx_pin), dma(dma), rx_ch(rx_ch),
+        tx_ch(tx_ch), rx_event(rx_event), tx_event(tx_event),
+        rx_lap_src(rx_lap_src), rx_lap_cb(rx_lap_cb) {}
+
+  void begin(uint32 baud) { HardwareSerial::begin(baud); dma_begin(); }
+  void begin(uint32 baud, uint8_t config) { HardwareSerial::begin(baud, config); dma_begin(); }
+
+  int available();
+  int peek();
+  int read();
+  int availableForWrite() { return TX_BUFFER_SIZE - tx_count; }
+  size_t write(uint8_t c);
+  void flush();
+
+  // Send the next TX chunk once the last one is done. Called from idle().
+  void task();
+
+  // Take in the bytes received so far and run the emergency parser over them.
+  // Called from idle(), so M108/M112/M410 get through while nothing reads the port.
+  void rx_update();
+
+  // End of an RX buffer lap, from the DMA transfer complete interrupt
+  void rx_lap_irq();
+
+  // Bytes lost when the RX buffer was lapped, and the number of times it happened
+  uint32_t dropped() const { return rx_dropped; }
+  uint32_t buffer_overruns() const { return rx_overruns; }
+
+private:
+  M4_DMA_TypeDef * const dma;
+  const uint8_t rx_ch, tx_ch;
+  const en_event_src_t rx_event, tx_event;
+  const en_int_src_t rx_lap_src;
+  const func_ptr_t rx_lap_cb;
+
+  volatile uint8_t rx_buffer[RX_BUFFER_SIZE];
+  volatile uint32_t rx_laps;              // Full laps of the RX buffer by the DMA
+  uint32_t rx_read, rx_parsed;            // Bytes read, and bytes taken in by rx_update(), since begin()
+  uint32_t rx_dropped, rx_overruns;
+
+  uint8_t tx_buffer[TX_BUFFER_SIZE];
+  uint16_t tx_head, tx_tail, tx_count,    // Ring of bytes not yet sent
+           tx_chunk;                      // Bytes handed to the DMA, starting at tx_tail
+
+  void dma_begin();
+  uint32_t rx_written();
+};
+
+#else
+
 struct MarlinSerial : public HardwareSerial {
   MarlinSerial(struct usart_config_t *config, uint8_t tx_pin, uint8_t rx_pin)
       : HardwareSerial(config, tx_pin, rx_pin) {}
@@ -55,6 +125,8 @@ struct MarlinSerial : public HardwareSerial {
 #endif
 };
 
+#endif // SERIAL_DMA
+
 typedef Serial1Class<MarlinSerial> MSerialT;
 
 // extern MSerialT MSerial1;
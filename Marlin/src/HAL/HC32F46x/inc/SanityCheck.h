@@ -32,8 +32,16 @@
 
 #if ENABLED(SERIAL_STATS_MAX_RX_QUEUED)
   #error "SERIAL_STATS_MAX_RX_QUEUED is not supported on the STM32F1 platform."
-#elif ENABLED(SERIAL_STATS_DROPPED_RX)
-  #error "SERIAL_STATS_DROPPED_RX is not supported on the STM32F1 platform."
+#elif ENABLED(SERIAL_STATS_DROPPED_RX) && DISABLED(SERIAL_DMA)
+  #error "SERIAL_STATS_DROPPED_RX requires SERIAL_DMA on the HC32F46x platform."
+#endif
+
+#if ENABLED(SERIAL_DMA)
+  #if !WITHIN(RX_BUFFER_SIZE, 32, 32768)
+    #error "SERIAL_DMA requires an RX_BUFFER_SIZE from 32 to 32768 (the DMA transfer count limit)."
+  #elif TX_BUFFER_SIZE < 16
+    #error "SERIAL_DMA requires a TX_BUFFER_SIZE of at least 16."
+  #endif
 #endif
 
 #if ENABLED(NEOPIXEL_LED) && DISABLED(FYSETC_MINI_12864_2_1)
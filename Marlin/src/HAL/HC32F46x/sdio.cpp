@@ -89,6 +89,20 @@ bool SDIO_ReadBlock(uint32_t block, uint8_t *dst) {
   return false;
 }
 
+bool SDIO_ReadBlocks(uint32_t block, uint8_t *dst, const uint8_t count) {
+  WITH_RETRY(SDIO_READ_RETRIES, {
+    en_result_t rc =
+        SDCARD_ReadBlocks(&cardHandle, block, count, dst, SDIO_TIMEOUT * count);
+    if (rc == Ok) {
+      return true;
+    } else {
+      printf("SDIO_ReadBlocks error (rc=%u)\n", rc);
+    }
+  })
+
+  return false;
+}
+
 bool SDIO_WriteBlock(uint32_t block, const uint8_t *src) {
   WITH_RETRY(SDIO_WRITE_RETRIES, {
     en_result_t rc =
@@ -103,6 +117,20 @@ bool SDIO_WriteBlock(uint32_t block, const uint8_t *src) {
   return false;
 }
 
+bool SDIO_WriteBlocks(uint32_t block, const uint8_t *src, const uint8_t count) {
+  WITH_RETRY(SDIO_WRITE_RETRIES, {
+    en_result_t rc =
+        SDCARD_WriteBlocks(&cardHandle, block, count, (uint8_t *)src, SDIO_TIMEOUT * count);
+    if (rc == Ok) {
+      return true;
+    } else {
+      printf("SDIO_WriteBlocks error (rc=%u)\n", rc);
+    }
+  })
+
+  return false;
+}
+
 bool SDIO_IsReady() { return bool(cardHandle.stcCardStatus.READY_FOR_DATA); }
 
 uint32_t SDIO_GetCardSize() {
@@ -27,8 +27,12 @@ bool SDIO_Init();
 
 bool SDIO_ReadBlock(uint32_t block, uint8_t *dst);
 
+bool SDIO_ReadBlocks(uint32_t block, uint8_t *dst, const uint8_t count);
+
 bool SDIO_WriteBlock(uint32_t block, const uint8_t *src);
 
+bool SDIO_WriteBlocks(uint32_t block, const uint8_t *src, const uint8_t count);
+
 bool SDIO_IsReady();
 
 uint32_t SDIO_GetCardSize();
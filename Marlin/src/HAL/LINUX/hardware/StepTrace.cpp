@@ -0,0 +1,76 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "StepTrace.h"
+
+#define STEP_TRACE_CHUNK (1UL << 20) // Records added each time the file grows
+
+StepTrace::StepTrace(std::string filename, const char *axis_names) {
+  header = nullptr;
+  capacity = 0;
+  fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || !grow()) { perror(filename.c_str()); return; }
+  memcpy(header->magic, "MSTRACE", 8);
+  header->version = STEP_TRACE_VERSION;
+  header->axes = strlen(axis_names);
+  strncpy(header->names, axis_names, sizeof(header->names));
+}
+
+StepTrace::~StepTrace() {
+  if (header) {
+    const uint64_t count = header->count;
+    munmap(header, sizeof(Header) + capacity * sizeof(uint64_t));
+    if (ftruncate(fd, sizeof(Header) + count * sizeof(uint64_t))) {} // Drop the unused tail
+  }
+  if (fd >= 0) close(fd);
+}
+
+// Extend the file and map it again. Records stay in place since the file only grows.
+bool StepTrace::grow() {
+  const uint64_t old_size = header ? sizeof(Header) + capacity * sizeof(uint64_t) : 0,
+                 new_capacity = capacity + STEP_TRACE_CHUNK,
+                 new_size = sizeof(Header) + new_capacity * sizeof(uint64_t);
+  if (ftruncate(fd, new_size)) return false;
+  if (header) munmap(header, old_size);
+  void *map = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) { header = nullptr; return false; }
+  header = (Header*)map;
+  capacity = new_capacity;
+  return true;
+}
+
+// Called for each step, from the thread running the Stepper ISR.
+void StepTrace::record(uint64_t timestamp, uint8_t axis, bool dir) {
+  if (!header) return;
+  if (header->count == capacity && !grow()) return;
+  uint64_t * const records = (uint64_t*)(header + 1);
+  records[header->count] = (timestamp << 8) | (axis << 1) | (dir ? 1 : 0);
+  header->count++; // The count is only advanced once the record is in place
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,72 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Binary step trace for host-side motion analysis.
+ *
+ * The file is memory-mapped, so a trace survives the simulator being killed.
+ * All values are little-endian:
+ *
+ *   Header (64 bytes)
+ *     char     magic[8]    "MSTRACE"
+ *     uint32_t version     STEP_TRACE_VERSION
+ *     uint32_t axes        Number of axes
+ *     uint64_t count       Number of records
+ *     char     names[8]    Axis names, e.g. "XYZE"
+ *     (zero padding)
+ *
+ *   Records (8 bytes each)
+ *     uint64_t (timestamp_ns << 8) | (axis << 1) | dir
+ *
+ * Each record is one step (rising edge of STEP) with the DIR level at that time.
+ * Analyze with buildroot/share/scripts/step_trace.py.
+ */
+
+#include <string>
+#include <stdint.h>
+
+#define STEP_TRACE_VERSION 1
+
+class StepTrace {
+public:
+  StepTrace(std::string filename, const char *axis_names);
+  ~StepTrace();
+  void record(uint64_t timestamp, uint8_t axis, bool dir);
+
+private:
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t axes;
+    uint64_t count;
+    char names[8];
+    uint8_t reserved[32];
+  };
+  static_assert(sizeof(Header) == 64, "StepTrace header must be 64 bytes.");
+
+  bool grow();
+
+  int fd;
+  Header *header;
+  uint64_t capacity; // Records that fit in the current mapping
+};
@@ -23,15 +23,21 @@
 #ifdef __PLAT_LINUX__
 
 //#define GPIO_LOGGING // Full GPIO and Positional Logging
+//#define STEP_TRACE   // Binary trace of every step. See buildroot/share/scripts/step_trace.py
+#if defined(STEP_TRACE) && !defined(STEP_TRACE_FILE)
+  #define STEP_TRACE_FILE "step_trace.bin"
+#endif
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/Delay.h"
 #include "hardware/IOLoggerCSV.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "hardware/StepTrace.h"
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <unistd.h>
 #include <thread>
 #include <iostream>
 #include <fstream>
@@ -42,9 +48,11 @@ extern void loop();
 // simple stdout / stdin implementation for fake serial port
 void write_serial_thread() {
   for (;;) {
-    for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
+    const std::size_t len = usb_serial.transmit_buffer.available();
+    for (std::size_t i = len; i > 0; i--) {
       fputc(usb_serial.transmit_buffer.read(), stdout);
     }
+    if (len) fflush(stdout); // Don't hold output back when stdout is a pipe
     std::this_thread::yield();
   }
 }
@@ -52,10 +60,11 @@ void write_serial_thread() {
 void read_serial_thread() {
   char buffer[255] = {};
   for (;;) {
-    std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
-    if (fgets(buffer, len, stdin))
-      for (std::size_t i = 0; i < strlen(buffer); i++)
-        usb_serial.receive_buffer.write(buffer[i]);
+    // Read raw bytes, not lines, so binary protocol packets get through intact
+    const std::size_t len = _MIN(usb_serial.receive_buffer.free(), 254U);
+    const ssize_t got = len ? read(STDIN_FILENO, buffer, len) : 0;
+    for (ssize_t i = 0; i < got; i++)
+      usb_serial.receive_buffer.write(buffer[i]);
     std::this_thread::yield();
   }
 }
@@ -68,6 +77,14 @@ void simulation_loop() {
   LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
   LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
 
+  #ifdef STEP_TRACE
+    StepTrace trace(STEP_TRACE_FILE, "XYZE");
+    x_axis.attachTrace(&trace, 0);
+    y_axis.attachTrace(&trace, 1);
+    z_axis.attachTrace(&trace, 2);
+    extruder0.attachTrace(&trace, 3);
+  #endif
+
   #ifdef GPIO_LOGGING
     IOLoggerCSV logger("all_gpio_log.csv");
     Gpio::attachLogger(&logger);
@@ -257,6 +257,14 @@
   #include "feature/easythreed_ui.h"
 #endif
 
+#if ENABLED(STEPPER_ISR_STATS)
+  #include "feature/stepper_isr_stats.h"
+#endif
+
+#if ENABLED(SEGMENT_MERGE)
+  #include "feature/segment_merge.h"
+#endif
+
 #if ENABLED(MARLIN_TEST_BUILD)
   #include "tests/marlin_tests.h"
 #endif
@@ -733,6 +741,7 @@ inline void manage_inactivity(const bool no_stepper_sleep=false) {
  *  - Core Marlin activities
  *  - Manage heaters (and Watchdog)
  *  - Max7219 heartbeat, animation, etc.
+ *  - Pass queued serial output to the ports
  *
  *  Only after setup() is complete:
  *  - Handle filament runout sensors
@@ -740,6 +749,8 @@ inline void manage_inactivity(const bool no_stepper_sleep=false) {
  *  - Handle Power-Loss Recovery
  *  - Run StallGuard endstop checks
  *  - Handle SD Card insert / remove
+ *  - Read ahead in the SD print file
+ *  - Write out buffered data of the SD file being saved
  *  - Handle USB Flash Drive insert / remove
  *  - Announce Host Keepalive state (if any)
  *  - Update the Print Job Timer state
@@ -772,6 +783,9 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   // Max7219 heartbeat, animation, etc
   TERN_(MAX7219_DEBUG, max7219.idle_tasks());
 
+  // Pass queued output to the serial ports
+  TERN_(SERIAL_TX_QUEUE, serial_tx_task());
+
   // Return if setup() isn't completed
   if (marlin_state == MF_INITIALIZING) goto IDLE_DONE;
 
@@ -804,6 +818,12 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   // Handle SD Card insert / remove
   TERN_(HAS_MEDIA, card.manage_media());
 
+  // Read ahead in the SD print file
+  TERN_(SDCARD_READ_AHEAD, card.readAhead());
+
+  // Write out buffered data of the file being saved
+  TERN_(SDCARD_WRITE_BEHIND, card.writeBehind());
+
   // Handle USB Flash Drive insert / remove
   TERN_(USB_FLASH_DRIVE_SUPPORT, card.diskIODriver()->idle());
 
@@ -840,6 +860,7 @@ void idle(const bool no_stepper_sleep/*=false*/) {
       TERN_(AUTO_REPORT_FANS, fan_check.auto_reporter.tick());
       TERN_(AUTO_REPORT_SD_STATUS, card.auto_reporter.tick());
       TERN_(AUTO_REPORT_POSITION, position_auto_reporter.tick());
+      TERN_(STEPPER_ISR_STATS, isr_stats_auto_reporter.tick());
       TERN_(BUFFER_MONITORING, queue.auto_report_buffer_statistics());
     }
   #endif
@@ -858,6 +879,9 @@ void idle(const bool no_stepper_sleep/*=false*/) {
   // Direct Stepping
   TERN_(DIRECT_STEPPING, page_manager.write_responses());
 
+  // Compile step tables for the next blocks
+  TERN_(STEP_COMPILER, step_compiler.task());
+
   // Update the LVGL interface
   TERN_(HAS_TFT_LVGL_UI, LV_TASK_HANDLER());
 
@@ -903,7 +927,10 @@ void kill(FSTR_P const lcd_error/*=nullptr*/, FSTR_P const lcd_component/*=nullp
 void minkill(const bool steppers_off/*=false*/) {
 
   // Wait a short time (allows messages to get out before shutting down.
-  for (int i = 1000; i--;) DELAY_US(600);
+  for (int i = 1000; i--;) {
+    DELAY_US(600);
+    TERN_(SERIAL_TX_QUEUE, serial_tx_task());
+  }
 
   cli(); // Stop interrupts
 
@@ -1672,6 +1699,8 @@ void loop() {
 
     queue.advance();
 
+    TERN_(SEGMENT_MERGE, segment_merge.task());
+
     #if ANY(POWER_OFF_TIMER, POWER_OFF_WAIT_FOR_COOLDOWN)
       powerManager.checkAutoPowerOff();
     #endif
@@ -27,6 +27,10 @@
   #include "../feature/ethernet.h"
 #endif
 
+#if ENABLED(SERIAL_TX_QUEUE)
+  #include "../MarlinCore.h"
+#endif
+
 uint8_t marlin_debug_flags = MARLIN_DEBUG_NONE;
 
 // Commonly-used strings in serial output
@@ -40,23 +44,35 @@ PGMSTR(SP_P_STR, " P"); PGMSTR(SP_T_STR, " T"); PGMSTR(NUL_STR,   "");
 MAP(_N_STR, LOGICAL_AXIS_NAMES); MAP(_SP_N_STR, LOGICAL_AXIS_NAMES);
 MAP(_N_LBL, LOGICAL_AXIS_NAMES); MAP(_SP_N_LBL, LOGICAL_AXIS_NAMES);
 
+#if HAS_MULTI_SERIAL && HAS_ETHERNET
+  // We need a definition here
+  SerialLeafT2 msSerial2(ethernet.have_telnet_client, MYSERIAL2, false);
+#endif
+
+// Queue the output of each leaf
+#if ENABLED(SERIAL_TX_QUEUE)
+  SerialQueueT1 tqSerial1(false, _SERIAL_LEAF_1);
+  #if HAS_MULTI_SERIAL
+    SerialQueueT2 tqSerial2(false, _SERIAL_LEAF_2);
+  #endif
+  #if NUM_SERIAL >= 3
+    SerialQueueT3 tqSerial3(false, _SERIAL_LEAF_3);
+  #endif
+#endif
+
 // Hook Meatpack if it's enabled on the first leaf
 #if ENABLED(MEATPACK_ON_SERIAL_PORT_1)
-  SerialLeafT1 mpSerial1(false, _SERIAL_LEAF_1);
+  SerialLeafT1 mpSerial1(false, _SERIAL_QUEUE_1);
 #endif
 #if ENABLED(MEATPACK_ON_SERIAL_PORT_2)
-  SerialLeafT2 mpSerial2(false, _SERIAL_LEAF_2);
+  SerialLeafT2 mpSerial2(false, _SERIAL_QUEUE_2);
 #endif
 #if ENABLED(MEATPACK_ON_SERIAL_PORT_3)
-  SerialLeafT3 mpSerial3(false, _SERIAL_LEAF_3);
+  SerialLeafT3 mpSerial3(false, _SERIAL_QUEUE_3);
 #endif
 
 // Step 2: For multiserial, handle the second serial port as well
 #if HAS_MULTI_SERIAL
-  #if HAS_ETHERNET
-    // We need a definition here
-    SerialLeafT2 msSerial2(ethernet.have_telnet_client, MYSERIAL2, false);
-  #endif
 
   #define __S_LEAF(N) ,SERIAL_LEAF_##N
   #define _S_LEAF(N) __S_LEAF(N)
@@ -85,6 +101,52 @@ void SERIAL_ECHO(serial_char_t x) { SERIAL_IMPL.write(x.c); }
 void SERIAL_FLUSH()    { SERIAL_IMPL.flush(); }
 void SERIAL_FLUSHTX()  { SERIAL_IMPL.flushTX(); }
 
+#if ENABLED(SERIAL_TX_QUEUE)
+
+  #if HAS_MULTI_SERIAL
+    #define _TXQ_ON(N) multiSerial.portMask.enabled(SerialOutputT::output[N])
+  #else
+    #define _TXQ_ON(N) true
+  #endif
+
+  void serial_tx_task() {
+    tqSerial1.tx_task();
+    TERN_(HAS_MULTI_SERIAL, tqSerial2.tx_task());
+    #if NUM_SERIAL >= 3
+      tqSerial3.tx_task();
+    #endif
+  }
+
+  bool serial_tx_pending() {
+    return (_TXQ_ON(0) && tqSerial1.tx_queued())
+      #if HAS_MULTI_SERIAL
+        || (_TXQ_ON(1) && tqSerial2.tx_queued())
+      #endif
+      #if NUM_SERIAL >= 3
+        || (_TXQ_ON(2) && tqSerial3.tx_queued())
+      #endif
+    ;
+  }
+
+  static bool serial_tx_room(const uint16_t bytes) {
+    return (!_TXQ_ON(0) || tqSerial1.tx_free() >= bytes)
+      #if HAS_MULTI_SERIAL
+        && (!_TXQ_ON(1) || tqSerial2.tx_free() >= bytes)
+      #endif
+      #if NUM_SERIAL >= 3
+        && (!_TXQ_ON(2) || tqSerial3.tx_free() >= bytes)
+      #endif
+    ;
+  }
+
+  void serial_tx_reserve(const uint16_t bytes) {
+    const uint16_t room = _MIN(bytes, uint16_t(SERIAL_TX_QUEUE_SIZE));
+    // Keep the machine running while the ports catch up. Once setup() is done.
+    while (marlin_state != MF_INITIALIZING && !serial_tx_room(room)) idle();
+  }
+
+#endif // SERIAL_TX_QUEUE
+
 void SERIAL_ECHO_P(PGM_P pstr) {
   while (const char c = pgm_read_byte(pstr++)) SERIAL_CHAR(c);
 }
@@ -61,13 +61,22 @@ extern uint8_t marlin_debug_flags;
   #define _SERIAL_LEAF_1 MYSERIAL1
 #endif
 
+// Queue the output of the first leaf
+#if ENABLED(SERIAL_TX_QUEUE)
+  typedef TxQueueSerial<decltype(_SERIAL_LEAF_1)> SerialQueueT1;
+  extern SerialQueueT1 tqSerial1;
+  #define _SERIAL_QUEUE_1 tqSerial1
+#else
+  #define _SERIAL_QUEUE_1 _SERIAL_LEAF_1
+#endif
+
 // Hook Meatpack if it's enabled on the first leaf
 #if ENABLED(MEATPACK_ON_SERIAL_PORT_1)
-  typedef MeatpackSerial<decltype(_SERIAL_LEAF_1)> SerialLeafT1;
+  typedef MeatpackSerial<decltype(_SERIAL_QUEUE_1)> SerialLeafT1;
   extern SerialLeafT1 mpSerial1;
   #define SERIAL_LEAF_1 mpSerial1
 #else
-  #define SERIAL_LEAF_1 _SERIAL_LEAF_1
+  #define SERIAL_LEAF_1 _SERIAL_QUEUE_1
 #endif
 
 // Step 2: For multiserial wrap all serial ports in a single
@@ -90,22 +99,37 @@ extern uint8_t marlin_debug_flags;
   // Nothing complicated here
   #define _SERIAL_LEAF_3 MYSERIAL3
 
+  // Queue the output of the other leaves
+  #if ENABLED(SERIAL_TX_QUEUE)
+    typedef TxQueueSerial<decltype(_SERIAL_LEAF_2)> SerialQueueT2;
+    extern SerialQueueT2 tqSerial2;
+    #define _SERIAL_QUEUE_2 tqSerial2
+    #if NUM_SERIAL >= 3
+      typedef TxQueueSerial<decltype(_SERIAL_LEAF_3)> SerialQueueT3;
+      extern SerialQueueT3 tqSerial3;
+      #define _SERIAL_QUEUE_3 tqSerial3
+    #endif
+  #else
+    #define _SERIAL_QUEUE_2 _SERIAL_LEAF_2
+    #define _SERIAL_QUEUE_3 _SERIAL_LEAF_3
+  #endif
+
   // Hook Meatpack if it's enabled on the second leaf
   #if ENABLED(MEATPACK_ON_SERIAL_PORT_2)
-    typedef MeatpackSerial<decltype(_SERIAL_LEAF_2)> SerialLeafT2;
+    typedef MeatpackSerial<decltype(_SERIAL_QUEUE_2)> SerialLeafT2;
     extern SerialLeafT2 mpSerial2;
     #define SERIAL_LEAF_2 mpSerial2
   #else
-    #define SERIAL_LEAF_2 _SERIAL_LEAF_2
+    #define SERIAL_LEAF_2 _SERIAL_QUEUE_2
   #endif
 
   // Hook Meatpack if it's enabled on the third leaf
   #if ENABLED(MEATPACK_ON_SERIAL_PORT_3)
-    typedef MeatpackSerial<decltype(_SERIAL_LEAF_3)> SerialLeafT3;
+    typedef MeatpackSerial<decltype(_SERIAL_QUEUE_3)> SerialLeafT3;
     extern SerialLeafT3 mpSerial3;
     #define SERIAL_LEAF_3 mpSerial3
   #else
-    #define SERIAL_LEAF_3 _SERIAL_LEAF_3
+    #define SERIAL_LEAF_3 _SERIAL_QUEUE_3
   #endif
 
   #define __S_MULTI(N) decltype(SERIAL_LEAF_##N),
@@ -158,6 +182,15 @@ template <typename T> void SERIAL_PRINTLN(T x, PrintBase y) { SERIAL_IMPL.printl
 void SERIAL_FLUSH();
 void SERIAL_FLUSHTX();
 
+#if ENABLED(SERIAL_TX_QUEUE)
+  // Pass queued output to the ports. Called from idle().
+  void serial_tx_task();
+  // Is output still queued for any of the current ports?
+  bool serial_tx_pending();
+  // Before writing a piece of a long report, run idle() until the current ports have room for it
+  void serial_tx_reserve(const uint16_t bytes);
+#endif
+
 // Start an echo: or error: output
 void SERIAL_ECHO_START();
 void SERIAL_ERROR_START();
@@ -72,6 +72,9 @@ CALL_IF_EXISTS_IMPL(void, flushTX);
 CALL_IF_EXISTS_IMPL(bool, connected, true);
 CALL_IF_EXISTS_IMPL(SerialFeature, features, SerialFeature::None);
 
+// availableForWrite is not implemented in all HAL, so -1 means the port can't say
+CALL_IF_EXISTS_IMPL(int, availableForWrite, -1);
+
 // A simple forward struct to prevent the compiler from selecting print(double, int) as a default overload
 // for any type other than double/float. For double/float, a conversion exists so the call will be invisible.
 struct EnsureDouble {
@@ -136,6 +136,60 @@ struct ForwardSerial : public SerialBase< ForwardSerial<SerialT> > {
   ForwardSerial(const bool e, SerialT & out) : BaseClassT(e), out(out) {}
 };
 
+#if ENABLED(SERIAL_TX_QUEUE)
+
+// Queue the output of a serial port and pass it on only as fast as the port takes it,
+// so writing doesn't wait on the port until the queue itself is full.
+// The queue is drained by write() and by tx_task(), which is called from idle().
+template <class SerialT>
+struct TxQueueSerial : public SerialBase< TxQueueSerial<SerialT> > {
+  typedef SerialBase< TxQueueSerial<SerialT> > BaseClassT;
+
+  static constexpr uint16_t mask = (SERIAL_TX_QUEUE_SIZE) - 1;
+
+  SerialT & out;
+  uint8_t queue[SERIAL_TX_QUEUE_SIZE];
+  uint16_t head, tail;  // Free-running indexes
+
+  uint16_t tx_queued() const { return uint16_t(head - tail); }
+  uint16_t tx_free() const   { return (SERIAL_TX_QUEUE_SIZE) - tx_queued(); }
+
+  // Pass queued bytes to the port while it has room. A port that can't tell gets them all.
+  void tx_task() {
+    if (!tx_queued()) return;
+    if (!connected()) { tail = head; return; }  // Nobody is listening
+    int room = CALL_IF_EXISTS(int, &out, availableForWrite);
+    for (; room && tx_queued(); room -= (room > 0)) out.write(queue[tail++ & mask]);
+  }
+
+  NO_INLINE void write(uint8_t c) {
+    tx_task();
+    if (!tx_queued() && CALL_IF_EXISTS(int, &out, availableForWrite)) { out.write(c); return; }
+    if (!tx_free()) out.write(queue[tail++ & mask]); // Wait on the port for room
+    queue[head++ & mask] = c;
+  }
+  void flushTX() {
+    while (tx_queued()) out.write(queue[tail++ & mask]);
+    CALL_IF_EXISTS(void, &out, flushTX);
+  }
+  void flush()                  { flushTX(); out.flush(); }
+  void begin(long br)           { out.begin(br); }
+  void end()                    { flushTX(); out.end(); }
+
+  void msgDone()                { out.msgDone(); }
+  bool connected()              { return CALL_IF_EXISTS(bool, &out, connected); }
+
+  int available(serial_index_t index) { return (int)out.available(index); }
+  int read(serial_index_t index)      { return (int)out.read(index); }
+  int available()               { return (int)out.available(); }
+  int read()                    { return (int)out.read(); }
+  SerialFeature features(serial_index_t index) const  { return CALL_IF_EXISTS(SerialFeature, &out, features, index);  }
+
+  TxQueueSerial(const bool e, SerialT & out) : BaseClassT(e), out(out), head(0), tail(0) {}
+};
+
+#endif // SERIAL_TX_QUEUE
+
 // A class that can be hooked and unhooked at runtime, useful to capture the output of the serial interface
 template <class SerialT>
 struct RuntimeSerial : public SerialBase< RuntimeSerial<SerialT> >, public SerialT {
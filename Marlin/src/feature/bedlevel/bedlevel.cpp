@@ -147,6 +147,7 @@ void reset_bed_level() {
       SERIAL_ECHOLNPGM("measured_z = ["); // open 2D array
     #endif
     for (uint8_t y = 0; y < sy; ++y) {
+      TERN_(SERIAL_TX_QUEUE, serial_tx_reserve(sx * (precision + 4) + 8)); // Room for the whole row
       #ifdef SCAD_MESH_OUTPUT
         SERIAL_ECHOPGM(" [");             // open sub-array
       #else
@@ -0,0 +1,169 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(BINARY_MOTION_STREAM)
+
+#include "binary_motion.h"
+#include "../gcode/gcode.h"
+#include "../module/motion.h"
+#include "../MarlinCore.h"
+
+#if ENABLED(PRINTCOUNTER)
+  #include "../module/printcounter.h"
+#endif
+
+#if ENABLED(SEGMENT_MERGE)
+  #include "segment_merge.h"
+#endif
+
+#if ENABLED(ARC_SUPPORT)
+  void plan_arc(const xyze_pos_t&, const ab_float_t&, const bool, const uint8_t);
+#endif
+
+xyze_long_t BinaryMotionProtocol::position;
+
+// Read a little-endian base-128 number, as used for all fields of a move
+static bool read_varint(const uint8_t *&p, const uint8_t * const end, uint32_t &v) {
+  v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    if (p >= end) return false;
+    const uint8_t b = *p++;
+    v |= uint32_t(b & 0x7F) << shift;
+    if (!TEST(b, 7)) return true;
+  }
+  return false;
+}
+
+// Read a signed number stored as 0, -1, 1, -2, 2, ...
+static bool read_zigzag(const uint8_t *&p, const uint8_t * const end, int32_t &v) {
+  uint32_t u;
+  if (!read_varint(p, end, u)) return false;
+  v = int32_t(u >> 1) ^ -int32_t(u & 1);
+  return true;
+}
+
+/**
+ * Start the stream from the current position and report it, along with
+ * the fixed-point scale, so the host can encode its first delta.
+ */
+void BinaryMotionProtocol::query() {
+  LOOP_NUM_AXES(i) position[i] = LROUND(NATIVE_TO_LOGICAL(current_position[i], i) * UNITS);
+  TERN_(HAS_EXTRUDERS, position.e = LROUND(current_position.e * UNITS));
+
+  SERIAL_ECHOPGM("PMS:version:", VERSION_MAJOR, ".", VERSION_MINOR, ".", VERSION_PATCH,
+                 ":units:", UNITS, ":arcs:", ENABLED(ARC_SUPPORT), ":position:");
+  LOOP_LOGICAL_AXES(i) {
+    if (i) SERIAL_CHAR(',');
+    SERIAL_CHAR(AXIS_CHAR(i));
+    SERIAL_ECHO(position[i]);
+  }
+  SERIAL_EOL();
+}
+
+/**
+ * Decode the moves of one packet and send each to the planner in turn.
+ * Return false on a malformed record, leaving the rest of the packet.
+ */
+bool BinaryMotionProtocol::moves(const uint8_t *data, const uint8_t * const end) {
+  constexpr float mm = 1.0f / UNITS;
+
+  while (data < end) {
+    const uint8_t code = *data++, g = code & 0x03;
+    if (code & ~0x07) return false;
+    if (g >= 2 && DISABLED(ARC_SUPPORT)) return false;
+
+    uint32_t mask;
+    if (!read_varint(data, end, mask) || (mask >> LOGICAL_AXES)) return false;
+
+    xyze_long_t target = position;
+    LOOP_LOGICAL_AXES(i) if (TEST(mask, i)) {
+      int32_t delta;
+      if (!read_zigzag(data, end, delta)) return false;
+      target[i] += delta;
+    }
+
+    uint32_t feedrate = 0;
+    if (TEST(code, 2) && !read_varint(data, end, feedrate)) return false;
+
+    int32_t a = 0, b = 0;
+    if (g >= 2 && !(read_zigzag(data, end, a) && read_zigzag(data, end, b))) return false;
+
+    // Track the host's position even if the move can't be done now
+    position = target;
+    if (!MOTION_CONDITIONS) continue;
+
+    if (feedrate) feedrate_mm_s = MMM_TO_MMS(feedrate);
+
+    LOOP_NUM_AXES(i) destination[i] = LOGICAL_TO_NATIVE(target[i] * mm, i);
+
+    #if HAS_EXTRUDERS
+      destination.e = target.e * mm;
+      #if ENABLED(PRINTCOUNTER)
+        if (!DEBUGGING(DRYRUN)) print_job_timer.incFilamentUsed(destination.e - current_position.e);
+      #endif
+    #endif
+
+    #if ENABLED(ARC_SUPPORT)
+      if (g >= 2) {
+        const ab_float_t offset = { a * mm, b * mm };
+        if (offset) {
+          TERN_(SEGMENT_MERGE, segment_merge.flush());
+          plan_arc(destination, offset, g == 2, 0);
+          gcode.reset_stepper_timeout();
+        }
+        else
+          SERIAL_ERROR_MSG(STR_ERR_ARC_ARGS);
+        continue;
+      }
+    #endif
+
+    #if ANY(IS_SCARA, POLAR)
+      if (g == 0) {
+        TERN_(SEGMENT_MERGE, segment_merge.flush());
+        prepare_fast_move_to_destination();
+      }
+      else
+    #endif
+        TERN(SEGMENT_MERGE, segment_merge.line_to_destination(), prepare_line_to_destination());
+  }
+
+  return true;
+}
+
+void BinaryMotionProtocol::process(const uint8_t packet_type, const char *buffer, const uint16_t length) {
+  switch (static_cast<MotionPacket>(packet_type)) {
+    case MotionPacket::QUERY:
+      query();
+      break;
+    case MotionPacket::MOVE: {
+      const uint8_t * const data = reinterpret_cast<const uint8_t*>(buffer);
+      if (!moves(data, data + length)) SERIAL_ECHOLNPGM("PMS:invalid");
+    } break;
+    default:
+      SERIAL_ECHOLNPGM("PMS:invalid");
+      break;
+  }
+}
+
+#endif // BINARY_MOTION_STREAM
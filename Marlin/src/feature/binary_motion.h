@@ -0,0 +1,56 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * binary_motion.h - Packed G0-G3 moves for the binary stream (Protocol 2)
+ *
+ * Each MOVE packet holds as many moves as fit the payload buffer, so one
+ * "ok" acknowledges the whole batch. A move record is:
+ *
+ *   uint8   Bits 0-1: G-code (G0-G3). Bit 2: F follows. Other bits zero.
+ *   varint  Mask of the axes that follow, bit n = logical axis n, E last.
+ *   zigzag  Each axis change in UNITS per mm, relative to the last move.
+ *   varint  F in mm/min, if flagged.
+ *   zigzag  G2/G3 only: the arc center offsets in UNITS per mm.
+ *
+ * Coordinates are absolute logical positions accumulated as integers, so
+ * deltas never drift. QUERY reports the starting point for the encoder.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class BinaryMotionProtocol {
+public:
+  static void process(const uint8_t packet_type, const char *buffer, const uint16_t length);
+
+  static constexpr int32_t UNITS = 1000;  // Fixed-point steps per mm
+  static const uint16_t VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
+
+private:
+  enum class MotionPacket : uint8_t { QUERY, MOVE };
+
+  static xyze_long_t position;            // Last position sent, in UNITS
+
+  static void query();
+  static bool moves(const uint8_t *data, const uint8_t * const end);
+};
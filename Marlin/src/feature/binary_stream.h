@@ -23,6 +23,10 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(BINARY_MOTION_STREAM)
+  #include "binary_motion.h"
+#endif
+
 #define BINARY_STREAM_COMPRESSION
 #if ENABLED(BINARY_STREAM_COMPRESSION)
   #include "../libs/heatshrink/heatshrink_decoder.h"
@@ -199,7 +203,7 @@ public:
 
 class BinaryStream {
 public:
-  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER };
+  enum class Protocol : uint8_t { CONTROL, FILE_TRANSFER, MOTION };
 
   enum class ProtocolControl : uint8_t { SYNC = 1, CLOSE };
 
@@ -278,6 +282,9 @@ public:
 
   template<const size_t buffer_size>
   void receive(char (&buffer)[buffer_size]) {
+    // Moves can wait for the planner, which runs idle() and gets back here
+    if (dispatching) return;
+
     uint8_t data = 0;
     millis_t transfer_window = millis() + RX_TIMESLICE;
 
@@ -394,7 +401,9 @@ public:
           bytes_received += packet.header.size;
 
           SERIAL_ECHOLNPGM("ok", packet.header.sync); // transmit valid packet received
+          dispatching = true;
           dispatch();
+          dispatching = false;
           stream_state = StreamState::PACKET_RESET;
           break;
         case StreamState::PACKET_RESEND:
@@ -436,6 +445,11 @@ public:
       case Protocol::FILE_TRANSFER:
         SDFileTransferProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // send user data to be processed
       break;
+      #if ENABLED(BINARY_MOTION_STREAM)
+        case Protocol::MOTION:
+          BinaryMotionProtocol::process(packet.header.type(), packet.buffer, packet.header.size); // moves go straight to the planner
+        break;
+      #endif
       default:
         SERIAL_ECHO_MSG("Unsupported Binary Protocol");
     }
@@ -448,6 +462,7 @@ public:
 
   static const uint16_t PACKET_MAX_WAIT = 500, RX_TIMESLICE = 20, MAX_RETRIES = 0, VERSION_MAJOR = 0, VERSION_MINOR = 1, VERSION_PATCH = 0;
   uint8_t  packet_retries, sync;
+  bool dispatching = false;
   uint16_t buffer_next_index;
   uint32_t bytes_received;
   StreamState stream_state = StreamState::PACKET_RESET;
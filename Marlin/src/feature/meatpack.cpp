@@ -204,6 +204,25 @@ void MeatPack::handle_rx_char(const uint8_t c, const serial_index_t serial_ind)
   handle_rx_char_inner(c);                // Other characters are passed on for MeatPack decoding
 }
 
+uint16_t MeatPack::decode(const uint8_t *in, uint16_t len, char *out, const serial_index_t serial_ind) {
+  char * const start = out;
+  while (len--) {
+    const uint8_t c = *in++;
+    // Packing on, nothing pending, and both nybbles packed? Then it's two characters from the table.
+    if (TEST(state, MPConfig_Bit_Active) && !(cmd_count | full_char_count | cmd_is_next)
+        && (c & kFirstNotPacked) != kFirstNotPacked && (c & kSecondNotPacked) != kSecondNotPacked
+    ) {
+      const char c1 = meatPackLookupTable[c & 0x0F];
+      *out++ = c1;
+      if (c1 != '\n') *out++ = meatPackLookupTable[c >> 4]; // After a newline the next char won't be set
+      continue;
+    }
+    handle_rx_char(c, serial_ind);
+    out += get_result_char(out);
+  }
+  return out - start;
+}
+
 uint8_t MeatPack::get_result_char(char * const __restrict out) {
   uint8_t res = 0;
   if (char_out_count) {
@@ -111,6 +111,15 @@ public:
    */
   uint8_t get_result_char(char * const __restrict out);
 
+  /**
+   * Decode a run of received bytes in one pass. Bytes that pack two characters
+   * go straight through the lookup table. Anything else goes through handle_rx_char.
+   * The input may be in the same buffer as the output, if it starts at least 'len'
+   * bytes in, since no byte ever decodes to more than 2 characters.
+   * @return Number of characters written to 'out'. Up to 2 * len.
+   */
+  uint16_t decode(const uint8_t *in, uint16_t len, char *out, const serial_index_t serial_ind);
+
   void reset_state();
   void report_state();
   uint8_t unpack_chars(const uint8_t pk, uint8_t* __restrict const chars_out);
@@ -126,10 +135,13 @@ template <typename SerialT>
 struct MeatpackSerial : public SerialBase <MeatpackSerial < SerialT >> {
   typedef SerialBase< MeatpackSerial<SerialT> > BaseClassT;
 
+  // Bytes to read from the port and decode in one go
+  static constexpr uint8_t kReadSize = 16;
+
   SerialT & out;
   MeatPack meatpack;
 
-  char serialBuffer[2];
+  char serialBuffer[kReadSize * 2];
   uint8_t charCount;
   uint8_t readIndex;
 
@@ -147,13 +159,19 @@ struct MeatpackSerial : public SerialBase <MeatpackSerial < SerialT >> {
 
   int available(serial_index_t index) {
     if (charCount) return charCount;          // The buffer still has data
-    if (out.available(index) <= 0) return 0;  // No data to read
 
-    // Don't read in read method, instead do it here, so we can make progress in the read method
-    const int r = out.read(index);
-    if (r == -1) return 0;  // This is an error from the underlying serial code
-    meatpack.handle_rx_char((uint8_t)r, index);
-    charCount = meatpack.get_result_char(serialBuffer);
+    // Don't read in read method, instead do it here, so we can make progress in the read method.
+    // Read what's waiting into the top half of the buffer and decode it to the bottom.
+    uint8_t * const in = (uint8_t*)serialBuffer + kReadSize;
+    uint8_t n = 0;
+    while (n < kReadSize && out.available(index) > 0) {
+      const int r = out.read(index);
+      if (r == -1) break;     // This is an error from the underlying serial code
+      in[n++] = (uint8_t)r;
+    }
+    if (!n) return 0;         // No data to read
+
+    charCount = meatpack.decode(in, n, serialBuffer, index);
     readIndex = 0;
 
     return charCount;
@@ -0,0 +1,102 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+#include "planner_benchmark.h"
+#include "../module/planner.h"
+
+PlannerBenchmark planner_bench;
+
+planner_bench_stage_t PlannerBenchmark::stage[PB_STAGE_COUNT];
+uint32_t PlannerBenchmark::blocks_planned, PlannerBenchmark::blocks_retired;
+uint64_t PlannerBenchmark::start_ns, PlannerBenchmark::last_ns;
+bool PlannerBenchmark::trace; // = false
+
+void PlannerBenchmark::reset() {
+  ZERO(stage);
+  blocks_planned = blocks_retired = 0;
+  start_ns = last_ns = 0;
+}
+
+void PlannerBenchmark::record(const PlannerBenchStage s, const uint64_t ns) {
+  planner_bench_stage_t &st = stage[s];
+  st.calls++;
+  st.total_ns += ns;
+  NOLESS(st.max_ns, ns);
+  NOLESS(st.max_blocks, st.pending);
+  st.pending = 0;
+  uint8_t b = 0;
+  for (uint64_t n = ns >> PLANNER_BENCH_MIN_SHIFT; n && b < PLANNER_BENCH_BUCKETS - 1; n >>= 1) b++;
+  st.histogram[b]++;
+}
+
+/**
+ * TRAP:<steps>,<initial>,<final>,<accel_until>,<decel_after>[,<cruise>,<accel_time>,<decel_time>]
+ * Rates are in steps/s and times in stepper timer ticks.
+ */
+void PlannerBenchmark::trace_block(block_t * const block) {
+  if (!block->is_move()) return;
+  SERIAL_ECHOPGM("TRAP:", block->step_event_count,
+    ",", block->initial_rate, ",", block->final_rate,
+    ",", block->accelerate_until, ",", block->decelerate_after
+  );
+  #if ENABLED(S_CURVE_ACCELERATION)
+    SERIAL_ECHOPGM(",", block->cruise_rate, ",", block->acceleration_time, ",", block->deceleration_time);
+  #endif
+  SERIAL_EOL();
+}
+
+void PlannerBenchmark::report() {
+  static const char * const stage_name[PB_STAGE_COUNT] = {
+    "command", "buffer_line", "populate", "reverse_pass", "forward_pass", "trapezoids", "serial"
+  };
+
+  const float secs = (last_ns - start_ns) * 1e-9f;
+  SERIAL_ECHOLNPGM("Planner Benchmark:"
+    " planned:", blocks_planned, " retired:", blocks_retired,
+    " time:", p_float_t(secs, 3), "s blocks/s:", p_float_t(secs > 0 ? blocks_planned / secs : 0, 1),
+    " commands/s:", p_float_t(secs > 0 ? stage[PB_COMMAND].calls / secs : 0, 1)
+  );
+
+  for (uint8_t s = 0; s < PB_STAGE_COUNT; ++s) {
+    const planner_bench_stage_t &st = stage[s];
+    SERIAL_ECHOPGM(" ", stage_name[s],
+      " calls:", st.calls,
+      " avg_ns:", uint32_t(st.calls ? st.total_ns / st.calls : 0),
+      " max_ns:", uint32_t(st.max_ns),
+      " total_ms:", uint32_t(st.total_ns / 1000000UL)
+    );
+    if (st.blocks) SERIAL_ECHOPGM(" avg_blocks:", p_float_t(float(st.blocks) / st.calls, 2), " max_blocks:", st.max_blocks);
+    SERIAL_ECHOPGM(" hist:");
+    // Bucket b holds latencies below 2^(b+8) ns; the last bucket is open-ended
+    for (uint8_t b = 0; b < PLANNER_BENCH_BUCKETS; ++b) {
+      if (b) SERIAL_CHAR(',');
+      SERIAL_ECHO(st.histogram[b]);
+    }
+    SERIAL_EOL();
+  }
+}
+
+#endif // PLANNER_BENCHMARK
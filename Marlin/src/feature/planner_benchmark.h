@@ -0,0 +1,105 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * planner_benchmark.h - Planner throughput and latency instrumentation
+ *
+ * Build for linux_native_benchmark and pipe a G-code file to stdin.
+ * The planner retires blocks itself when the buffer fills, so nothing
+ * is stepped and the look-ahead window stays as full as in a real print.
+ * Use M960 to report blocks/sec, commands/sec, per-stage time and latency histograms.
+ * M960 T1 echoes every retired block so two builds can be compared.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+#ifdef __PLAT_LINUX__
+  #define PLANNER_BENCH_NOW() uint64_t(Clock::nanos())
+#else
+  #define PLANNER_BENCH_NOW() (uint64_t(micros()) * 1000UL)
+#endif
+
+// Log2 latency buckets. Bucket 0 is everything under 256ns.
+#define PLANNER_BENCH_BUCKETS    16
+#define PLANNER_BENCH_MIN_SHIFT   8
+
+enum PlannerBenchStage : uint8_t {
+  PB_COMMAND,               // GcodeSuite::process_next_command, end to end
+  PB_BUFFER_LINE,           // Planner::buffer_line, end to end
+  PB_POPULATE,              // Planner::_populate_block
+  PB_REVERSE_PASS,          // Planner::reverse_pass
+  PB_FORWARD_PASS,          // Planner::forward_pass
+  PB_TRAPEZOIDS,            // Planner::recalculate_trapezoids
+  PB_SERIAL,                // GCodeQueue::get_serial_commands, when there's input
+  PB_STAGE_COUNT
+};
+
+struct PlannerBlock;
+
+typedef struct {
+  uint32_t calls;
+  uint64_t total_ns, max_ns;
+  uint32_t histogram[PLANNER_BENCH_BUCKETS];
+  uint32_t blocks;                  // Blocks visited by the passes, over all calls
+  uint16_t max_blocks, pending;     // Most blocks visited in one call, count for the current call
+} planner_bench_stage_t;
+
+class PlannerBenchmark {
+public:
+  static planner_bench_stage_t stage[PB_STAGE_COUNT];
+  static uint32_t blocks_planned, blocks_retired;
+  static uint64_t start_ns, last_ns;
+  static bool trace;
+
+  static void reset();
+  static void report();
+
+  // Echo the trapezoid of a block, for comparing builds with planner_benchmark.py
+  static void trace_block(PlannerBlock * const block);
+
+  static void record(const PlannerBenchStage s, const uint64_t ns);
+
+  // Count a move added to the queue, starting the clock on the first one
+  static void block_planned() {
+    last_ns = PLANNER_BENCH_NOW();
+    if (!blocks_planned++) start_ns = last_ns;
+  }
+
+  // Count a move or sync block taken off the queue
+  static void block_retired() { blocks_retired++; }
+
+  // Count a block visited by one of the planner passes
+  static void touched(const PlannerBenchStage s) { stage[s].blocks++; stage[s].pending++; }
+
+  // Time a scope and add it to the given stage, unless it's not active by the end
+  class Timer {
+    const PlannerBenchStage s;
+    const uint64_t t0;
+  public:
+    bool active;
+    Timer(const PlannerBenchStage s, const bool active=true) : s(s), t0(PLANNER_BENCH_NOW()), active(active) {}
+    ~Timer() { if (active) record(s, PLANNER_BENCH_NOW() - t0); }
+  };
+};
+
+extern PlannerBenchmark planner_bench;
@@ -0,0 +1,149 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(SEGMENT_MERGE)
+
+#include "segment_merge.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+
+SegmentMerge segment_merge;
+
+bool SegmentMerge::enabled = true;
+float SegmentMerge::tolerance = SEGMENT_MERGE_TOLERANCE;
+uint32_t SegmentMerge::moves, SegmentMerge::blocks;
+
+bool SegmentMerge::pending;
+uint8_t SegmentMerge::count;
+xyze_pos_t SegmentMerge::start, SegmentMerge::end;
+feedRate_t SegmentMerge::feedrate;
+float SegmentMerge::length;
+xyze_pos_t SegmentMerge::joint[(SEGMENT_MERGE_MAX) - 1];
+
+/**
+ * Can the move from 'end' to 'destination' join the held line?
+ * The new line from 'start' to 'destination' must pass within the
+ * chord tolerance of every joint, in order, with the same feedrate
+ * and about the same E/XYZ ratio.
+ */
+bool SegmentMerge::can_merge() {
+  if (count >= SEGMENT_MERGE_MAX || feedrate_mm_s != feedrate) return false;
+
+  float seg_sq = 0;
+  LOOP_NUM_AXES(i) seg_sq += sq(destination[i] - end[i]);
+  if (!seg_sq) return false;              // E-only moves are never merged
+
+  #if HAS_EXTRUDERS
+    const float seg_ratio = (destination.e - end.e) / SQRT(seg_sq),
+                line_ratio = (end.e - start.e) / length;
+    if (ABS(seg_ratio - line_ratio) > (SEGMENT_MERGE_E_TOLERANCE) * 0.01f * _MAX(ABS(seg_ratio), ABS(line_ratio)))
+      return false;
+  #endif
+
+  xyze_float_t u;
+  float uu = 0;
+  LOOP_NUM_AXES(i) { u[i] = destination[i] - start[i]; uu += sq(u[i]); }
+
+  // Each joint must project inside the line, past the one before it, and lie close to it
+  float prev_pu = 0;
+  auto near_line = [&](const xyze_pos_t &p) {
+    float pu = 0;
+    LOOP_NUM_AXES(i) pu += (p[i] - start[i]) * u[i];
+    if (pu <= prev_pu || pu >= uu) return false;
+    prev_pu = pu;
+    const float t = pu / uu;
+    float d_sq = 0;
+    LOOP_NUM_AXES(i) d_sq += sq(p[i] - start[i] - t * u[i]);
+    return d_sq <= sq(tolerance);
+  };
+
+  for (uint8_t j = 0; j < count - 1; ++j) if (!near_line(joint[j])) return false;
+  return near_line(end);
+}
+
+void SegmentMerge::line_to_destination() {
+  if (!enabled) { flush(); return prepare_line_to_destination(); }
+
+  moves++;
+  apply_motion_limits(destination);
+
+  if (pending && can_merge()) {
+    joint[count - 1] = end;
+    count++;
+    float seg_sq = 0;
+    LOOP_NUM_AXES(i) seg_sq += sq(destination[i] - end[i]);
+    length += SQRT(seg_sq);
+  }
+  else {
+    flush();
+    float len_sq = 0;
+    LOOP_NUM_AXES(i) len_sq += sq(destination[i] - current_position[i]);
+    if (!len_sq) {                        // E-only moves go straight to the planner
+      blocks++;
+      return prepare_line_to_destination();
+    }
+    pending = true;
+    count = 1;
+    start = current_position;
+    feedrate = feedrate_mm_s;
+    length = SQRT(len_sq);
+  }
+
+  end = destination;
+  current_position = destination;
+}
+
+void SegmentMerge::_flush() {
+  pending = false;
+  blocks++;
+
+  // Plan the held line with the state it was given, then restore the current state.
+  // The planner calls this before any other move or position change, when the caller
+  // may have already moved current_position on.
+  const xyze_pos_t old_position = current_position, old_destination = destination;
+  const feedRate_t old_feedrate = feedrate_mm_s;
+  current_position = start;
+  destination = end;
+  feedrate_mm_s = feedrate;
+  prepare_line_to_destination();
+  current_position = old_position;
+  destination = old_destination;
+  feedrate_mm_s = old_feedrate;
+}
+
+void SegmentMerge::task() {
+  // Hold the move only while the planner has enough to run meanwhile. The command queue
+  // says nothing, since it's empty between lines from a host that waits for every "ok".
+  if (pending && planner.movesplanned() < (BLOCK_BUFFER_SIZE) / 4) _flush();
+}
+
+void SegmentMerge::report() {
+  SERIAL_ECHOLNPGM("Segment merge:", enabled ? " on" : " off",
+    " tolerance:", p_float_t(tolerance, 3),
+    " moves:", moves, " blocks:", blocks,
+    " ratio:", p_float_t(blocks ? float(moves) / blocks : 0, 2)
+  );
+}
+
+#endif // SEGMENT_MERGE
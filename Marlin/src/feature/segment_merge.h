@@ -0,0 +1,70 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * segment_merge.h - Merge runs of collinear G0/G1 moves into one planner block
+ *
+ * A move is held back until the next one shows whether it continues in a
+ * straight line. Moves are merged while every joint stays within the chord
+ * tolerance of the merged line and the E/XYZ ratio and feedrate don't
+ * change. Any other command, or any other move or position change that
+ * reaches the planner, sends the held move on first. Use M962 to report
+ * how many moves went into each block.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+class SegmentMerge {
+public:
+  static bool enabled;
+  static float tolerance;           // (mm) Chord tolerance
+  static uint32_t moves, blocks;    // Moves taken in, merged lines sent to the planner
+
+  // Queue a line from current_position to destination, merging it if possible
+  static void line_to_destination();
+
+  // Send the held move to the planner
+  static void flush() { if (pending) _flush(); }
+
+  // Drop the held move, as on quick stop
+  static void discard() { pending = false; }
+
+  // Send the held move on when the planner runs low
+  static void task();
+
+  static void reset() { moves = blocks = 0; }
+  static void report();
+
+private:
+  static bool pending;
+  static uint8_t count;             // Moves merged into the held line
+  static xyze_pos_t start, end;     // The held line. current_position is already at the end.
+  static feedRate_t feedrate;
+  static float length;              // Length of the path through the joints
+  static xyze_pos_t joint[(SEGMENT_MERGE_MAX) - 1]; // Ends of all but the last merged move
+
+  static bool can_merge();
+  static void _flush();
+};
+
+extern SegmentMerge segment_merge;
@@ -0,0 +1,110 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEP_COMPILER)
+
+#include "step_compiler.h"
+#include "../module/stepper.h"
+
+StepCompiler step_compiler;
+
+step_table_t StepCompiler::table[STEP_COMPILER_BLOCKS];
+volatile StepTableState StepCompiler::state[STEP_COMPILER_BLOCKS]; // = ST_FREE
+
+#if ENABLED(STEP_COMPILER_CHECK)
+  uint32_t StepCompiler::checked_events, StepCompiler::mismatches;
+#endif
+
+/**
+ * The same Bresenham line tracer as PULSE_PREP in Stepper::pulse_phase_isr,
+ * initialized as in Stepper::block_phase_isr.
+ */
+void StepCompiler::compile(step_table_t &t, const block_t * const block, const uint8_t oversampling) {
+  const uint32_t step_event_count = block->step_event_count << oversampling,
+                 advance_divisor = step_event_count << 1;
+  const xyze_long_t advance_dividend = (block->steps << 1).asLong();
+  xyze_long_t delta_error;
+  delta_error = -int32_t(step_event_count);
+
+  const uint16_t events = _MIN(step_event_count, uint32_t(STEP_COMPILER_EVENTS));
+  for (uint16_t n = 0; n < events; ++n) {
+    AxisFlags step_needed{0};
+    LOOP_LOGICAL_AXES(i) {
+      int32_t de = delta_error[i] + advance_dividend[i];
+      if (de >= 0) {
+        step_needed.set(i);
+        de -= advance_divisor;
+      }
+      delta_error[i] = de;
+    }
+    t.event[n] = step_needed;
+  }
+
+  t.step_event_count = step_event_count;
+  t.steps = block->steps;
+  t.delta_error = delta_error;
+  t.events = events;
+}
+
+void StepCompiler::task() {
+  #if ENABLED(STEP_COMPILER_CHECK)
+    // Report each time the Stepper finds new differences
+    static uint32_t reported;
+    const uint32_t m = mismatches;
+    if (m != reported) {
+      reported = m;
+      SERIAL_ERROR_MSG("Step table mismatches:", m, " events:", checked_events);
+    }
+  #endif
+
+  // The Stepper uses the table for the block at its index, so only look ahead as many blocks as there are tables
+  uint8_t b = planner.block_buffer_tail;
+  for (uint8_t n = 0; n < STEP_COMPILER_BLOCKS && b != planner.block_buffer_head; ++n, b = BLOCK_MOD(b + 1)) {
+    block_t * const block = &planner.block_buffer[b];
+    if (!block->is_move() || stepper.is_block_busy(block)) continue;
+
+    const uint8_t s = b & (STEP_COMPILER_BLOCKS - 1),
+                  oversampling = TERN0(ADAPTIVE_STEP_SMOOTHING, Stepper::calc_oversampling(block->nominal_rate));
+    if (state[s] == ST_READY && matches(table[s], block, block->step_event_count << oversampling)) continue;
+
+    // Claim the table unless the Stepper is reading from it
+    bool was_on = hal.isr_state();
+    hal.isr_off();
+    const bool claimed = stepper.step_table != &table[s];
+    if (claimed) state[s] = ST_COMPILING;
+    if (was_on) hal.isr_on();
+    if (!claimed) continue;
+
+    compile(table[s], block, oversampling);
+
+    was_on = hal.isr_state();
+    hal.isr_off();
+    state[s] = ST_READY;
+    if (was_on) hal.isr_on();
+
+    break; // One block per call
+  }
+}
+
+#endif // STEP_COMPILER
@@ -0,0 +1,87 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * step_compiler.h - Pre-compiled step events for the Stepper ISR
+ *
+ * While the main loop is idle the next few blocks are run through the same
+ * Bresenham line tracer as the Stepper ISR, storing the steppers that step on
+ * each step event. When the Stepper starts a block that has a ready table it
+ * reads one entry per event in place of the line tracer. For blocks with more
+ * events than the table holds, tracing resumes from the stored delta errors.
+ *
+ * A table is keyed by the step counts it was compiled from, not by the block,
+ * so a stale table can never be applied to the wrong move.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../module/planner.h"
+
+typedef struct {
+  uint32_t step_event_count;              // Step events, including oversampling
+  abce_ulong_t steps;                     // Steps of the block the table was compiled from
+  xyze_long_t delta_error;                // Bresenham delta errors after the last entry
+  uint16_t events;                        // Entries in the table
+  AxisFlags event[STEP_COMPILER_EVENTS];  // Steppers to step on each event
+} step_table_t;
+
+enum StepTableState : uint8_t { ST_FREE, ST_COMPILING, ST_READY };
+
+class StepCompiler {
+public:
+  static step_table_t table[STEP_COMPILER_BLOCKS];
+  static volatile StepTableState state[STEP_COMPILER_BLOCKS];
+
+  // Compile a table for the next queued block that doesn't have one. Called from idle().
+  static void task();
+
+  // Run the line tracer for a block and store the step events in a table
+  static void compile(step_table_t &t, const block_t * const block, const uint8_t oversampling);
+
+  // Check that a table was compiled for the same steps and event count
+  static bool matches(const step_table_t &t, const block_t * const block, const uint32_t step_event_count) {
+    return t.step_event_count == step_event_count && t.steps == block->steps;
+  }
+
+  // The ready table for the block at the given index, or nullptr. For the Stepper ISR.
+  static const step_table_t* table_for(const uint8_t block_index, const block_t * const block, const uint32_t step_event_count) {
+    const uint8_t s = block_index & (STEP_COMPILER_BLOCKS - 1);
+    return (state[s] == ST_READY && matches(table[s], block, step_event_count)) ? &table[s] : nullptr;
+  }
+
+  #if ENABLED(STEP_COMPILER_CHECK)
+    static uint32_t checked_events, mismatches;
+
+    // Compare a table entry with the live line tracer. For the Stepper ISR.
+    // Return false after the last entry, with the delta errors also compared.
+    static bool check(const step_table_t &t, const uint16_t n, const AxisFlags &live, const xyze_long_t &delta_error) {
+      checked_events++;
+      if (t.event[n].flags.b != live.flags.b) mismatches++;
+      if (n + 1U < t.events) return true;
+      if (t.delta_error != delta_error) mismatches++;
+      return false;
+    }
+  #endif
+};
+
+extern StepCompiler step_compiler;
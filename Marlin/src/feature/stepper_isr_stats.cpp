@@ -0,0 +1,83 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_STATS)
+
+#include "stepper_isr_stats.h"
+#include "../module/stepper.h"
+
+StepperISRStats stepper_isr_stats;
+AutoReporter<StepperISRStats> isr_stats_auto_reporter;
+
+isr_phase_stats_t StepperISRStats::phase[ISR_PHASE_COUNT];
+millis_t StepperISRStats::start_ms;
+
+void StepperISRStats::reset() {
+  const bool was_enabled = stepper.suspend();
+  ZERO(phase);
+  start_ms = millis();
+  if (was_enabled) stepper.wake_up();
+}
+
+void StepperISRStats::report() {
+  static const char * const phase_name[ISR_PHASE_COUNT] = {
+    "pulse", "block", "advance", "shaping", "babystep", "total"
+  };
+  static constexpr bool phase_used[ISR_PHASE_COUNT] = {
+    true, true, ENABLED(LIN_ADVANCE), ENABLED(HAS_ZV_SHAPING), ENABLED(BABYSTEPPING), true
+  };
+
+  // Take a consistent copy of everything before printing, since the
+  // ISR keeps updating it and 64-bit totals can't be read atomically
+  const bool was_enabled = stepper.suspend();
+  isr_phase_stats_t snap[ISR_PHASE_COUNT];
+  COPY(snap, phase);
+  const millis_t elapsed_ms = millis() - start_ms;
+  if (was_enabled) stepper.wake_up();
+
+  // Share of the elapsed time spent in the ISR. At 100% the steppers can't keep up.
+  const float secs = MS_TO_SEC_PRECISE(elapsed_ms);
+  const float load = secs > 0 ? snap[ISR_TOTAL].total / (secs * (STEPPER_TIMER_RATE)) * 100.0f : 0;
+  SERIAL_ECHOLNPGM("Stepper ISR: time:", p_float_t(secs, 1), "s load:", p_float_t(load, 2), "% ticks/us:", STEPPER_TIMER_TICKS_PER_US);
+
+  for (uint8_t p = 0; p < ISR_PHASE_COUNT; ++p) {
+    if (!phase_used[p]) continue;
+    const isr_phase_stats_t &st = snap[p];
+
+    SERIAL_ECHOPGM(" ", phase_name[p],
+      " calls:", st.calls,
+      " avg:", p_float_t(st.calls ? float(st.total) / st.calls : 0, 2),
+      " max:", uint32_t(st.max),
+      " hist:"
+    );
+    // Bucket b holds times below 2^(b+1) ticks; the last bucket is open-ended
+    for (uint8_t b = 0; b < ISR_STATS_BUCKETS; ++b) {
+      if (b) SERIAL_CHAR(',');
+      SERIAL_ECHO(st.histogram[b]);
+    }
+    SERIAL_EOL();
+  }
+}
+
+#endif // STEPPER_ISR_STATS
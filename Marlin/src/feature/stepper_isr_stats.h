@@ -0,0 +1,84 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * stepper_isr_stats.h - Time spent in each phase of the Stepper ISR
+ *
+ * Times are read from the stepper timer, so they work on every HAL and
+ * are in ticks of STEPPER_TIMER_RATE. Use M961 to report them.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "../libs/autoreport.h"
+
+// Log2 buckets of timer ticks. Bucket 0 holds 0 or 1 tick.
+#define ISR_STATS_BUCKETS 12
+
+enum StepperISRPhase : uint8_t {
+  ISR_PULSE,                // Stepper::pulse_phase_isr
+  ISR_BLOCK,                // Stepper::block_phase_isr
+  ISR_ADVANCE,              // Stepper::advance_isr
+  ISR_SHAPING,              // Stepper::shaping_isr
+  ISR_BABYSTEP,             // Stepper::babystepping_isr
+  ISR_TOTAL,                // Stepper::isr, from the timer firing to the next compare
+  ISR_PHASE_COUNT
+};
+
+typedef struct {
+  uint32_t calls;
+  uint64_t total;
+  hal_timer_t max;
+  uint32_t histogram[ISR_STATS_BUCKETS];
+} isr_phase_stats_t;
+
+class StepperISRStats {
+public:
+  static isr_phase_stats_t phase[ISR_PHASE_COUNT];
+  static millis_t start_ms;
+
+  static void reset();
+  static void report();
+
+  // Called from the Stepper ISR, so keep it short
+  static void record(const StepperISRPhase p, const hal_timer_t ticks) {
+    isr_phase_stats_t &st = phase[p];
+    st.calls++;
+    st.total += ticks;
+    NOLESS(st.max, ticks);
+    uint8_t b = 0;
+    for (hal_timer_t t = ticks >> 1; t && b < ISR_STATS_BUCKETS - 1; t >>= 1) b++;
+    st.histogram[b]++;
+  }
+
+  // Time a scope in the Stepper ISR and add it to the given phase
+  class Timer {
+    const StepperISRPhase p;
+    const hal_timer_t t0;
+  public:
+    Timer(const StepperISRPhase p) : p(p), t0(HAL_timer_get_count(MF_TIMER_STEP)) {}
+    ~Timer() { record(p, HAL_timer_get_count(MF_TIMER_STEP) - t0); }
+  };
+};
+
+extern StepperISRStats stepper_isr_stats;
+extern AutoReporter<StepperISRStats> isr_stats_auto_reporter;
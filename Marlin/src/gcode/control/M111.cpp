@@ -56,7 +56,7 @@ void GcodeSuite::M111() {
   else {
     SERIAL_ECHOPGM(STR_DEBUG_OFF);
     #if !defined(__AVR__) || !defined(USBCON)
-      #if ENABLED(SERIAL_STATS_RX_BUFFER_OVERRUNS)
+      #if ANY(SERIAL_STATS_RX_BUFFER_OVERRUNS, SERIAL_DMA)
         SERIAL_ECHOPGM("\nBuffer Overruns: ", MYSERIAL1.buffer_overruns());
       #endif
 
@@ -64,7 +64,7 @@ void GcodeSuite::M111() {
         SERIAL_ECHOPGM("\nFraming Errors: ", MYSERIAL1.framing_errors());
       #endif
 
-      #if ENABLED(SERIAL_STATS_DROPPED_RX)
+      #if ANY(SERIAL_STATS_DROPPED_RX, SERIAL_DMA)
         SERIAL_ECHOPGM("\nDropped bytes: ", MYSERIAL1.dropped());
       #endif
 
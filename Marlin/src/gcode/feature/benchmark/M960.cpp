@@ -0,0 +1,49 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+#include "../../gcode.h"
+#include "../../../module/planner.h"
+#include "../../../feature/planner_benchmark.h"
+
+/**
+ * M960: Planner benchmark report
+ *
+ *   With no parameters, drain the planner and report
+ *
+ *   R : Reset the counters (after reporting, if also reporting)
+ *   S : Skip the report
+ *   T<bool> : Echo the trapezoid of every block as it's retired. Skews the timings.
+ */
+void GcodeSuite::M960() {
+  if (!parser.seen_test('S')) {
+    planner.synchronize();
+    planner_bench.report();
+  }
+  if (parser.seen_test('R')) planner_bench.reset();
+  if (parser.seen('T')) planner_bench.trace = parser.value_bool();
+}
+
+#endif // PLANNER_BENCHMARK
@@ -97,6 +97,14 @@ void say_shaping() {
   #endif
 }
 
+void say_buffer() {
+  const ft_buff_stats_t &b = fxdTiCtrl.buffStats;
+  SERIAL_ECHOLNPGM("Command buffer underruns: ", b.underruns,
+    " high-water: ", b.highWater, " low-water: ", b.lowWater, " of ", FTM_STEPPERCMD_BUFF_SIZE,
+    " (pre-fill ", FTM_STEPPERCMD_PREFILL, ")"
+  );
+}
+
 void GcodeSuite::M493_report(const bool forReplay/*=true*/) {
   report_heading_etc(forReplay, F(STR_FT_MOTION));
   const ft_config_t &c = fxdTiCtrl.cfg;
@@ -149,15 +157,27 @@ void GcodeSuite::M493_report(const bool forReplay/*=true*/) {
  *
  *    B<Hz> Set static/base frequency for the Y axis
  *    H<Hz> Set frequency scaling for the Y axis
+ *
+ *    R Reset the command buffer statistics
+ *
+ * With no parameters, also report the command buffer statistics.
  */
 void GcodeSuite::M493() {
-  struct { bool update_n:1, update_a:1, reset_ft:1, report_h:1; } flag = { false };
+  struct { bool update_n:1, update_a:1, reset_ft:1, report_h:1, report_b:1; } flag = { false };
 
   if (!parser.seen_any())
-    flag.report_h = true;
+    flag.report_h = flag.report_b = true;
   else
     planner.synchronize();
 
+  // Reset the command buffer statistics.
+  if (parser.seen_test('R')) {
+    const bool was_on = hal.isr_state();
+    hal.isr_off();
+    fxdTiCtrl.buffStats.reset();
+    if (was_on) hal.isr_on();
+  }
+
   // Parse 'S' mode parameter.
   if (parser.seenval('S')) {
     const ftMotionMode_t oldmm = fxdTiCtrl.cfg.mode,
@@ -218,18 +238,18 @@ void GcodeSuite::M493() {
         switch (val) {
           case dynFreqMode_DISABLED:
             fxdTiCtrl.cfg.dynFreqMode = val;
-            flag.report_h = true;
+            flag.update_n = flag.report_h = true;
             break;
           #if HAS_DYNAMIC_FREQ_MM
             case dynFreqMode_Z_BASED:
               fxdTiCtrl.cfg.dynFreqMode = val;
-              flag.report_h = true;
+              flag.update_n = flag.report_h = true;
               break;
           #endif
           #if HAS_DYNAMIC_FREQ_G
             case dynFreqMode_MASS_BASED:
               fxdTiCtrl.cfg.dynFreqMode = val;
-              flag.report_h = true;
+              flag.update_n = flag.report_h = true;
               break;
           #endif
           default:
@@ -272,7 +292,7 @@ void GcodeSuite::M493() {
       if (parser.seenval('F')) {
         if (modeUsesDynFreq) {
           fxdTiCtrl.cfg.dynFreqK[X_AXIS] = parser.value_float();
-          flag.report_h = true;
+          flag.update_n = flag.report_h = true;
         }
         else
           SERIAL_ECHOLNPGM("Wrong mode for [", AS_CHAR('F'), "] frequency scaling.");
@@ -303,7 +323,7 @@ void GcodeSuite::M493() {
       if (parser.seenval('H')) {
         if (modeUsesDynFreq) {
           fxdTiCtrl.cfg.dynFreqK[Y_AXIS] = parser.value_float();
-          flag.report_h = true;
+          flag.update_n = flag.report_h = true;
         }
         else
           SERIAL_ECHOLNPGM("Wrong mode for [", AS_CHAR('H'), "] frequency scaling.");
@@ -318,6 +338,7 @@ void GcodeSuite::M493() {
   #endif
   if (flag.reset_ft) fxdTiCtrl.reset();
   if (flag.report_h) say_shaping();
+  if (flag.report_b) say_buffer();
 
 }
 
@@ -0,0 +1,47 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(SEGMENT_MERGE)
+
+#include "../../gcode.h"
+#include "../../../feature/segment_merge.h"
+
+/**
+ * M962: Segment merging
+ *
+ *   With no parameters, report the settings and the merge ratio
+ *
+ *   S<bool> : Enable or disable merging
+ *   T<mm>   : Set the chord tolerance
+ *   R       : Reset the counters
+ */
+void GcodeSuite::M962() {
+  bool report = true;
+  if (parser.seen('S')) { segment_merge.enabled = parser.value_bool(); report = false; }
+  if (parser.seenval('T')) { segment_merge.tolerance = _MAX(parser.value_linear_units(), 0.0f); report = false; }
+  if (parser.seen_test('R')) { segment_merge.reset(); report = false; }
+  if (report) segment_merge.report();
+}
+
+#endif // SEGMENT_MERGE
@@ -69,6 +69,14 @@ GcodeSuite gcode;
   #include "../feature/fancheck.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../feature/segment_merge.h"
+#endif
+
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "../feature/planner_benchmark.h"
+#endif
+
 #include "../MarlinCore.h" // for idle, kill
 
 // Inactivity shutdown
@@ -102,6 +110,8 @@ relative_t GcodeSuite::axis_relative; // Init in constructor
 
 void GcodeSuite::report_echo_start(const bool forReplay) { if (!forReplay) SERIAL_ECHO_START(); }
 void GcodeSuite::report_heading(const bool forReplay, FSTR_P const fstr, const bool eol/*=true*/) {
+  // Long reports like M503 go out a section at a time
+  TERN_(SERIAL_TX_QUEUE, serial_tx_reserve((SERIAL_TX_QUEUE_SIZE) / 2));
   if (forReplay) return;
   if (fstr) {
     SERIAL_ECHO_START();
@@ -334,6 +344,9 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
     }
   #endif
 
+  // Only G0/G1 can join a held move, so send it on before any other command
+  TERN_(SEGMENT_MERGE, if (!(parser.command_letter == 'G' && parser.codenum <= 1)) segment_merge.flush());
+
   // Handle a known command or reply "unknown command"
 
   switch (parser.command_letter) {
@@ -1055,6 +1068,22 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
         case 951: M951(); break;                                  // M951: Set Magnetic Parking Extruder parameters
       #endif
 
+      #if ENABLED(PLANNER_BENCHMARK)
+        case 960: M960(); break;                                  // M960: Planner benchmark report
+      #endif
+
+      #if ENABLED(STEPPER_ISR_STATS)
+        case 961: M961(); break;                                  // M961: Stepper ISR statistics
+      #endif
+
+      #if ENABLED(SEGMENT_MERGE)
+        case 962: M962(); break;                                  // M962: Segment merge settings and report
+      #endif
+
+      #if ENABLED(SDCARD_BLOCK_CACHE)
+        case 963: M963(); break;                                  // M963: SD block cache statistics
+      #endif
+
       #if ENABLED(Z_STEPPER_AUTO_ALIGN)
         case 422: M422(); break;                                  // M422: Set Z Stepper automatic alignment position using probe
       #endif
@@ -1138,6 +1167,8 @@ void GcodeSuite::process_parsed_command(const bool no_ok/*=false*/) {
  * This is called from the main loop()
  */
 void GcodeSuite::process_next_command() {
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Timer bench(PB_COMMAND));
+
   GCodeQueue::CommandLine &command = queue.ring_buffer.peek_next_command();
 
   PORT_REDIRECT(SERIAL_PORTMASK(command.port));
@@ -1154,7 +1185,12 @@ void GcodeSuite::process_next_command() {
   }
 
   // Parse the next command in the queue
-  parser.parse(command.buffer);
+  #if ENABLED(PRETOKENIZED_GCODE)
+    if (command.parsed.command_letter)
+      parser.load(command.buffer, command.parsed);
+    else
+  #endif
+      parser.parse(command.buffer);
   process_parsed_command();
 }
 
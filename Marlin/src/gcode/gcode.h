@@ -302,6 +302,10 @@
  * M919 - Get or Set motor Chopper Times (time_off, hysteresis_end, hysteresis_start) using axis codes XYZE, etc. If no parameters are given, report. (Requires at least one _DRIVER_TYPE defined as TMC2130/2160/5130/5160/2208/2209/2660)
  * M936 - OTA update firmware. (Requires OTA_FIRMWARE_UPDATE)
  * M951 - Set Magnetic Parking Extruder parameters. (Requires MAGNETIC_PARKING_EXTRUDER)
+ * M960 - Report or reset planner benchmark counters. (Requires PLANNER_BENCHMARK)
+ * M961 - Report or reset Stepper ISR statistics. S<seconds> sets the auto-report interval. (Requires STEPPER_ISR_STATS)
+ * M962 - Set segment merging and report the merge ratio. (Requires SEGMENT_MERGE)
+ * M963 - Report or reset SD block cache statistics. (Requires SDCARD_BLOCK_CACHE)
  * M3426 - Read MCP3426 ADC over I2C. (Requires HAS_MCP3426_ADC)
  * M7219 - Control Max7219 Matrix LEDs. (Requires MAX7219_GCODE)
  *
@@ -1225,6 +1229,22 @@ private:
     static void M951();
   #endif
 
+  #if ENABLED(PLANNER_BENCHMARK)
+    static void M960();
+  #endif
+
+  #if ENABLED(STEPPER_ISR_STATS)
+    static void M961();
+  #endif
+
+  #if ENABLED(SEGMENT_MERGE)
+    static void M962();
+  #endif
+
+  #if ENABLED(SDCARD_BLOCK_CACHE)
+    static void M963();
+  #endif
+
   #if ENABLED(TOUCH_SCREEN_CALIBRATION)
     static void M995();
   #endif
@@ -107,6 +107,12 @@ void GcodeSuite::M115() {
     // BINARY_FILE_TRANSFER (M28 B1)
     cap_line(F("BINARY_FILE_TRANSFER"), ENABLED(BINARY_FILE_TRANSFER)); // TODO: Use SERIAL_IMPL.has_feature(port, SerialFeature::BinaryFileTransfer) once implemented
 
+    // BINARY_MOTION_STREAM (M28 B1, Protocol 2)
+    cap_line(F("BINARY_MOTION"), ENABLED(BINARY_MOTION_STREAM));
+
+    // CREDIT_FLOW_CONTROL (W<line> in "ok")
+    cap_line(F("CREDIT_FLOW_CONTROL"), ENABLED(CREDIT_FLOW_CONTROL));
+
     // EEPROM (M500, M501)
     cap_line(F("EEPROM"), ENABLED(EEPROM_SETTINGS));
 
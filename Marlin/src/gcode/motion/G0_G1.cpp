@@ -35,6 +35,10 @@
   #include "../../module/planner.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../../feature/segment_merge.h"
+#endif
+
 extern xyze_pos_t destination;
 
 #if ENABLED(VARIABLE_G0_FEEDRATE)
@@ -82,6 +86,7 @@ void GcodeSuite::G0_G1(TERN_(HAS_FAST_MOVES, const bool fast_move/*=false*/)) {
         const float echange = destination.e - current_position.e;
         // Is this a retract or recover move?
         if (WITHIN(ABS(echange), MIN_AUTORETRACT, MAX_AUTORETRACT) && fwretract.retracted[active_extruder] == (echange > 0.0)) {
+          TERN_(SEGMENT_MERGE, segment_merge.flush()); // Send any held move first
           current_position.e = destination.e;       // Hide a G1-based retract/recover from calculations
           sync_plan_position_e();                   // AND from the planner
           return fwretract.retract(echange < 0.0);  // Firmware-based retract/recover (double-retract ignored)
@@ -92,10 +97,13 @@ void GcodeSuite::G0_G1(TERN_(HAS_FAST_MOVES, const bool fast_move/*=false*/)) {
   #endif // FWRETRACT
 
   #if ANY(IS_SCARA, POLAR)
-    fast_move ? prepare_fast_move_to_destination() : prepare_line_to_destination();
-  #else
-    prepare_line_to_destination();
+    if (fast_move) {
+      TERN_(SEGMENT_MERGE, segment_merge.flush());
+      prepare_fast_move_to_destination();
+    }
+    else
   #endif
+      TERN(SEGMENT_MERGE, segment_merge.line_to_destination(), prepare_line_to_destination());
 
   #ifdef G0_FEEDRATE
     // Restore the motion mode feedrate
@@ -66,6 +66,12 @@ uint16_t GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if ENABLED(PRETOKENIZED_GCODE)
+  uint32_t GCodeParser::valuebits;      // converted values
+  const float *GCodeParser::values;     // values of the loaded command
+  int8_t GCodeParser::value_index = -1; // value for value_ptr
+#endif
+
 // Create a global instance of the GCode parser singleton
 GCodeParser parser;
 
@@ -84,6 +90,10 @@ void GCodeParser::reset() {
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
   #endif
+  #if ENABLED(PRETOKENIZED_GCODE)
+    valuebits = 0;                      // No converted values
+    value_index = -1;
+  #endif
 }
 
 #if ENABLED(GCODE_QUOTED_STRINGS)
@@ -369,6 +379,77 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if ENABLED(PRETOKENIZED_GCODE)
+
+  /**
+   * Parse a line as it is queued, converting its numeric parameters.
+   * This may run from idle() within a command handler, so the state
+   * of the running command is saved and restored around the parse.
+   */
+  void GCodeParser::preparse(char * const p, parsed_command_t &out) {
+    char * const sv_command_ptr = command_ptr, * const sv_string_arg = string_arg, * const sv_value_ptr = value_ptr;
+    const char sv_command_letter = command_letter;
+    const uint16_t sv_codenum = codenum;
+    TERN_(USE_GCODE_SUBCODES, const uint8_t sv_subcode = subcode);
+    const uint32_t sv_codebits = codebits, sv_valuebits = valuebits;
+    const float * const sv_values = values;
+    const int8_t sv_value_index = value_index;
+    uint8_t sv_param[COUNT(param)];
+    COPY(sv_param, param);
+
+    parse(p);
+
+    out.command_offset = command_ptr - p;
+    out.string_offset = string_arg ? string_arg - command_ptr : 0;
+    out.command_letter = command_letter;
+    out.codenum = codenum;
+    TERN_(USE_GCODE_SUBCODES, out.subcode = subcode);
+    out.codebits = codebits;
+    COPY(out.param, param);
+
+    // Convert numeric values the same way value_float() would
+    out.valuebits = 0;
+    for (uint8_t ind = 0, n = 0; ind < COUNT(param) && n < COUNT(out.value); ++ind) {
+      if (!TEST32(codebits, ind) || !param[ind]) continue;
+      char * const ptr = command_ptr + param[ind];
+      if (!valid_number(ptr)) continue;
+      value_ptr = ptr;
+      out.value[n++] = value_float();
+      SBI32(out.valuebits, ind);
+    }
+
+    command_ptr = sv_command_ptr;
+    string_arg = sv_string_arg;
+    value_ptr = sv_value_ptr;
+    command_letter = sv_command_letter;
+    codenum = sv_codenum;
+    TERN_(USE_GCODE_SUBCODES, subcode = sv_subcode);
+    codebits = sv_codebits;
+    valuebits = sv_valuebits;
+    values = sv_values;
+    value_index = sv_value_index;
+    COPY(param, sv_param);
+  }
+
+  /**
+   * Populate the command line state from a line given to preparse(),
+   * without scanning it again.
+   */
+  void GCodeParser::load(char * const p, const parsed_command_t &in) {
+    command_ptr = p + in.command_offset;
+    string_arg = in.string_offset ? command_ptr + in.string_offset : nullptr;
+    command_letter = in.command_letter;
+    codenum = in.codenum;
+    TERN_(USE_GCODE_SUBCODES, subcode = in.subcode);
+    codebits = in.codebits;
+    COPY(param, in.param);
+    valuebits = in.valuebits;
+    values = in.value;
+    value_index = -1;
+  }
+
+#endif // PRETOKENIZED_GCODE
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
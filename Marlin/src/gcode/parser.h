@@ -29,6 +29,10 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(FAST_NUMBER_PARSER)
+  #include "../libs/strtonum.h"
+#endif
+
 //#define DEBUG_GCODE_PARSER
 #if ENABLED(DEBUG_GCODE_PARSER)
   #include "../libs/hex_print.h"
@@ -42,6 +46,26 @@
   typedef enum : uint8_t { LINEARUNIT_MM, LINEARUNIT_INCH } LinearUnit;
 #endif
 
+#if ENABLED(PRETOKENIZED_GCODE)
+  /**
+   * A command parsed when it was queued, ready to load into the parser.
+   * Offsets are from the start of the line and of the command.
+   */
+  typedef struct ParsedCommand {
+    uint32_t codebits,                        // Parameters seen
+             valuebits;                       // Parameters with a converted value
+    float value[PRETOKENIZED_GCODE_VALUES];   // Converted values, in letter order
+    uint8_t param[26];                        // For A-Z, offsets into command args
+    uint16_t codenum;
+    #if USE_GCODE_SUBCODES
+      uint8_t subcode;
+    #endif
+    uint8_t command_offset,                   // Command start, after any line number
+            string_offset;                    // string_arg, or 0 for none
+    char command_letter;                      // G, M, or T. NUL if not parsed.
+  } parsed_command_t;
+#endif
+
 /**
  * GCode parser
  *
@@ -66,6 +90,12 @@ private:
     static char *command_args;      // Args start here, for slow scan
   #endif
 
+  #if ENABLED(PRETOKENIZED_GCODE)
+    static uint32_t valuebits;      // Parameters with a converted value
+    static const float *values;     // Converted values of the loaded command
+    static int8_t value_index;      // Set by seen, the converted value or -1
+  #endif
+
 public:
 
   // Global states for GCode-level units features
@@ -153,6 +183,9 @@ public:
         }
         else
           value_ptr = nullptr;
+        #if ENABLED(PRETOKENIZED_GCODE)
+          value_index = TEST32(valuebits, ind) ? __builtin_popcountl(valuebits & (_BV32(ind) - 1)) : -1;
+        #endif
       }
       return b;
     }
@@ -237,6 +270,13 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if ENABLED(PRETOKENIZED_GCODE)
+    // Parse a queued line ahead of time, leaving the current command intact
+    static void preparse(char * const p, parsed_command_t &out);
+    // Populate all fields from a line parsed by preparse
+    static void load(char * const p, const parsed_command_t &in);
+  #endif
+
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     // Parse the next parameter as a new command
     static bool chain();
@@ -256,29 +296,39 @@ public:
 
   // Float removes 'E' to prevent scientific notation interpretation
   static float value_float() {
+    TERN_(PRETOKENIZED_GCODE, if (value_index >= 0) return values[value_index]);
     if (!value_ptr) return 0;
-    char *e = value_ptr;
-    for (;;) {
-      const char c = *e;
-      if (c == '\0' || c == ' ') break;
-      if (c == 'E' || c == 'e' || c == 'X' || c == 'x') {
-        *e = '\0';
-        const float ret = strtof(value_ptr, nullptr);
-        *e = c;
-        return ret;
+    #if ENABLED(FAST_NUMBER_PARSER)
+      return dectof(value_ptr); // Stops at 'E' and 'X' by itself
+    #else
+      char *e = value_ptr;
+      for (;;) {
+        const char c = *e;
+        if (c == '\0' || c == ' ') break;
+        if (c == 'E' || c == 'e' || c == 'X' || c == 'x') {
+          *e = '\0';
+          const float ret = strtof(value_ptr, nullptr);
+          *e = c;
+          return ret;
+        }
+        ++e;
       }
-      ++e;
-    }
-    return strtof(value_ptr, nullptr);
+      return strtof(value_ptr, nullptr);
+    #endif
   }
 
+  #if ENABLED(FAST_NUMBER_PARSER)
+    // Code value in fixed point with the given decimal places, rounded
+    static int32_t value_fixed(const uint8_t places) { return value_ptr ? dectofix(value_ptr, places) : 0; }
+  #endif
+
   // Code value as a long or ulong
   static int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
   static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
 
   // Code value for use as time
   static millis_t value_millis() { return value_ulong(); }
-  static millis_t value_millis_from_seconds() { return (millis_t)SEC_TO_MS(value_float()); }
+  static millis_t value_millis_from_seconds() { return (millis_t)TERN(FAST_NUMBER_PARSER, value_fixed(3), SEC_TO_MS(value_float())); }
 
   // Reduce to fewer bits
   static int16_t value_int() { return (int16_t)value_long(); }
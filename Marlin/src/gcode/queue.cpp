@@ -57,6 +57,10 @@ GCodeQueue queue;
   #include "../feature/repeat.h"
 #endif
 
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "../feature/planner_benchmark.h"
+#endif
+
 // Frequently used G-code strings
 PGMSTR(G28_STR, "G28");
 
@@ -103,11 +107,35 @@ void GCodeQueue::RingBuffer::commit_command(const bool skip_ok
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
   commands[index_w].skip_ok = skip_ok;
+  #if ENABLED(PRETOKENIZED_GCODE)
+    // Parse now, unless the raw line is going to be written to SD
+    if (TERN1(HAS_MEDIA, !card.flag.saving))
+      parser.preparse(commands[index_w].buffer, commands[index_w].parsed);
+    else
+      commands[index_w].parsed.command_letter = '\0';
+  #endif
   TERN_(HAS_MULTI_SERIAL, commands[index_w].port = serial_ind);
   TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
   advance_pos(index_w, 1);
 }
 
+#if ENABLED(COMMAND_ARENA)
+
+  /**
+   * Queue the line being assembled in an arena, in place.
+   */
+  void GCodeQueue::RingBuffer::commit_command(CommandArena &a, const uint8_t len, const bool skip_ok
+    OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
+  ) {
+    CommandLine &command = commands[index_w];
+    command.buffer = a.commit(len);
+    command.arena = &a;
+    command.length = len;
+    commit_command(skip_ok OPTARG(HAS_MULTI_SERIAL, serial_ind));
+  }
+
+#endif
+
 /**
  * Copy a command from RAM into the main command buffer.
  * Return true if the command was successfully added.
@@ -117,8 +145,16 @@ bool GCodeQueue::RingBuffer::enqueue(const char *cmd, const bool skip_ok/*=true*
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
   if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(commands[index_w].buffer, cmd);
-  commit_command(skip_ok OPTARG(HAS_MULTI_SERIAL, serial_ind));
+  #if ENABLED(COMMAND_ARENA)
+    if (!arena.reserve()) return false;
+    char (&line)[MAX_CMD_SIZE] = arena.line();
+    strncpy(line, cmd, MAX_CMD_SIZE - 1);
+    line[MAX_CMD_SIZE - 1] = '\0';
+    commit_command(arena, strlen(line), skip_ok OPTARG(HAS_MULTI_SERIAL, serial_ind));
+  #else
+    strcpy(commands[index_w].buffer, cmd);
+    commit_command(skip_ok OPTARG(HAS_MULTI_SERIAL, serial_ind));
+  #endif
   return true;
 }
 
@@ -232,6 +268,22 @@ void GCodeQueue::enqueue_now_P(PGM_P const pgcode) {
   }
 }
 
+#if ENABLED(CREDIT_FLOW_CONTROL)
+  #if ENABLED(COMMAND_ARENA)
+    // A line only leaves the RX buffer when the port's arena has room for a whole line,
+    // as it always has while holding fewer than COMMAND_ARENA_SIZE / MAX_CMD_SIZE - 1.
+    // Lines in flight may all be MAX_CMD_SIZE long, so they must fit in those and RX.
+    #if RX_BUFFER_SIZE
+      #define CREDIT_RX_LINES ((RX_BUFFER_SIZE - 1) / (MAX_CMD_SIZE))
+    #else
+      #define CREDIT_RX_LINES 0
+    #endif
+    constexpr uint8_t credit_lines = _MIN(BUFSIZE, (COMMAND_ARENA_SIZE) / (MAX_CMD_SIZE) - 1 + CREDIT_RX_LINES);
+  #else
+    constexpr uint8_t credit_lines = BUFSIZE;
+  #endif
+#endif
+
 /**
  * Send an "ok" message to the host, indicating
  * that a command was successfully processed.
@@ -240,6 +292,13 @@ void GCodeQueue::enqueue_now_P(PGM_P const pgcode) {
  *   N<int>  Line number of the command, if any
  *   P<int>  Planner space remaining
  *   B<int>  Block queue space remaining
+ *
+ * If CREDIT_FLOW_CONTROL is enabled also include:
+ *   W<int>  Last line number the host may send for now. Only this port's
+ *           lines count against the queue, so the credit never goes down
+ *           when SD or injected commands fill slots. Lines sent ahead wait
+ *           in the RX buffer until there's room, so with COMMAND_ARENA
+ *           no more are allowed than the arena and RX buffer can hold.
  */
 void GCodeQueue::RingBuffer::ok_to_send() {
   #if NO_TIMEOUTS > 0
@@ -262,6 +321,13 @@ void GCodeQueue::RingBuffer::ok_to_send() {
         SERIAL_CHAR(*p++);
     }
     SERIAL_ECHOPGM_P(SP_P_STR, planner.moves_free(), SP_B_STR, BUFSIZE - length);
+    #if ENABLED(CREDIT_FLOW_CONTROL)
+      // Count this port's lines, including the one this command is about to release
+      uint8_t lines = 0;
+      for (uint8_t i = 0, r = index_r; i < length; ++i, r = (r + 1) % BUFSIZE)
+        if (!commands[r].skip_ok && TERN1(HAS_MULTI_SERIAL, commands[r].port.index == command.port.index)) lines++;
+      SERIAL_ECHOPGM(" W", serial_state[command_port().index].last_N + (credit_lines + 1) - lines);
+    #endif
   #endif
   SERIAL_EOL();
 }
@@ -325,9 +391,12 @@ void GCodeQueue::gcode_line_error(FSTR_P const ferr, const serial_index_t serial
   PORT_REDIRECT(SERIAL_PORTMASK(serial_ind)); // Reply to the serial port that sent the command
   SERIAL_ERROR_START();
   SERIAL_ECHOLN(ferr, serial_state[serial_ind.index].last_N);
-  while (read_serial(serial_ind) != -1) { /* nada */ } // Clear out the RX buffer. Why don't use flush here ?
+  #if DISABLED(CREDIT_FLOW_CONTROL)
+    while (read_serial(serial_ind) != -1) { /* nada */ } // Clear out the RX buffer. Why don't use flush here ?
+  #endif
   flush_and_request_resend(serial_ind);
   serial_state[serial_ind.index].count = 0;
+  TERN_(CREDIT_FLOW_CONTROL, serial_state[serial_ind.index].resend_pending = true);
 }
 
 FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", but not "M290", etc
@@ -421,7 +490,13 @@ void GCodeQueue::get_serial_commands() {
        * receive buffer (which limits the packet size to MAX_CMD_SIZE).
        * The receive buffer also limits the packet size for reliable transmission.
        */
-      binaryStream[card.transfer_port_index.index].receive(serial_state[card.transfer_port_index.index].line_buffer);
+      #if ENABLED(COMMAND_ARENA)
+        // A packet is received over several calls, so it can't sit in an arena that moves lines around
+        static char packet_buffer[MAX_CMD_SIZE];
+        binaryStream[card.transfer_port_index.index].receive(packet_buffer);
+      #else
+        binaryStream[card.transfer_port_index.index].receive(serial_state[card.transfer_port_index.index].line());
+      #endif
       return;
     }
   #endif
@@ -436,6 +511,9 @@ void GCodeQueue::get_serial_commands() {
     }
   #endif
 
+  // Time reading and splitting the input, only counting calls that get some
+  TERN_(PLANNER_BENCHMARK, PlannerBenchmark::Timer bench(PB_SERIAL, false));
+
   // Loop while serial characters are incoming and the queue is not full
   for (bool hadData = true; hadData;) {
     // Unless a serial port has data, this will exit on next iteration
@@ -448,8 +526,14 @@ void GCodeQueue::get_serial_commands() {
       // No data for this port ? Skip it
       if (!serial_data_available(p)) continue;
 
+      #if ENABLED(COMMAND_ARENA)
+        // Before starting a new line, make sure the arena can hold it
+        if (!serial_state[p].count && !serial_state[p].arena.reserve()) continue;
+      #endif
+
       // Ok, we have some data to process, let's make progress here
       hadData = true;
+      TERN_(PLANNER_BENCHMARK, bench.active = true);
 
       const int c = read_serial(p);
       if (c < 0) {
@@ -468,14 +552,24 @@ void GCodeQueue::get_serial_commands() {
       if (ISEOL(serial_char)) {
 
         // Reset our state, continue if the line was empty
-        if (process_line_done(serial.input_state, serial.line_buffer, serial.count))
+        TERN_(COMMAND_ARENA, const uint8_t len = serial.count); // Length before it's reset
+        if (process_line_done(serial.input_state, serial.line(), serial.count))
           continue;
 
-        char* command = serial.line_buffer;
+        char* command = serial.line();
 
         while (*command == ' ') command++;                   // Skip leading spaces
         char *npos = (*command == 'N') ? command : nullptr;  // Require the N parameter to start the line
 
+        #if ENABLED(CREDIT_FLOW_CONTROL)
+          // Lines sent after the bad one are still arriving, possibly starting mid-line.
+          // Drop everything but the requested line (or M110) until it comes back.
+          if (serial.resend_pending
+            && !(npos && strtol(npos + 1, nullptr, 10) == serial.last_N + 1)
+            && !strstr_P(command, PSTR("M110"))
+          ) continue;
+        #endif
+
         if (npos) {
 
           const bool M110 = !!strstr_P(command, PSTR("M110"));
@@ -511,6 +605,7 @@ void GCodeQueue::get_serial_commands() {
           }
 
           serial.last_N = gcode_N;
+          TERN_(CREDIT_FLOW_CONTROL, serial.resend_pending = false);
         }
         #if HAS_MEDIA
           // Pronterface "M29" and "M29 " has no line number
@@ -553,10 +648,14 @@ void GCodeQueue::get_serial_commands() {
         #endif
 
         // Add the command to the queue
-        ring_buffer.enqueue(serial.line_buffer, false OPTARG(HAS_MULTI_SERIAL, p));
+        #if ENABLED(COMMAND_ARENA)
+          if (*serial.line() != ';') ring_buffer.commit_command(serial.arena, len, false OPTARG(HAS_MULTI_SERIAL, p));
+        #else
+          ring_buffer.enqueue(serial.line_buffer, false OPTARG(HAS_MULTI_SERIAL, p));
+        #endif
       }
       else
-        process_stream_char(serial_char, serial.input_state, serial.line_buffer, serial.count);
+        process_stream_char(serial_char, serial.input_state, serial.line(), serial.count);
 
     } // NUM_SERIAL loop
   } // queue has space, serial has data
@@ -578,31 +677,43 @@ void GCodeQueue::get_serial_commands() {
 
     int sd_count = 0;
     while (!ring_buffer.full() && !card.eof()) {
+      #if ENABLED(COMMAND_ARENA)
+        // Lines are only left unfinished at the end of the file, so check for room between lines
+        if (!sd_count && !ring_buffer.arena.reserve()) break;
+        char (&buffer)[MAX_CMD_SIZE] = ring_buffer.arena.line();
+      #else
+        char (&buffer)[MAX_CMD_SIZE] = ring_buffer.commands[ring_buffer.index_w].buffer;
+      #endif
+
       const int16_t n = card.get();
       const bool card_eof = card.eof();
       if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
 
-      CommandLine &command = ring_buffer.commands[ring_buffer.index_w];
       const char sd_char = (char)n;
       const bool is_eol = ISEOL(sd_char);
       if (is_eol || card_eof) {
 
         // Reset stream state, terminate the buffer, and commit a non-empty command
         if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command.buffer, sd_count)) {
+        TERN_(COMMAND_ARENA, const uint8_t len = sd_count); // Length before it's reset
+        if (!process_line_done(sd_input_state, buffer, sd_count)) {
 
           // M808 L saves the sdpos of the next line. M808 loops to a new sdpos.
-          TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command.buffer));
+          TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(buffer));
 
           #if DISABLED(PARK_HEAD_ON_PAUSE)
             // When M25 is non-blocking it can still suspend SD commands
             // Otherwise the M125 handler needs to know SD printing is active
-            if (command.buffer[0] == 'M' && command.buffer[1] == '2' && command.buffer[2] == '5' && !NUMERIC(command.buffer[3]))
+            if (buffer[0] == 'M' && buffer[1] == '2' && buffer[2] == '5' && !NUMERIC(buffer[3]))
               card.pauseSDPrint();
           #endif
 
           // Put the new command into the buffer (no "ok" sent)
-          ring_buffer.commit_command(true);
+          #if ENABLED(COMMAND_ARENA)
+            ring_buffer.commit_command(ring_buffer.arena, len, true);
+          #else
+            ring_buffer.commit_command(true);
+          #endif
 
           // Prime Power-Loss Recovery for the NEXT commit_command
           TERN_(POWER_LOSS_RECOVERY, recovery.cmd_sdpos = card.getIndex());
@@ -611,7 +722,7 @@ void GCodeQueue::get_serial_commands() {
         if (card.eof()) card.fileHasFinished();         // Handle end of file reached
       }
       else
-        process_stream_char(sd_char, sd_input_state, command.buffer, sd_count);
+        process_stream_char(sd_char, sd_input_state, buffer, sd_count);
     }
   }
 
@@ -667,6 +778,8 @@ void GCodeQueue::advance() {
     }
   #endif
 
+  const uint8_t generation = ring_buffer.generation;
+
   #if HAS_MEDIA
 
     if (card.flag.saving) {
@@ -705,7 +818,11 @@ void GCodeQueue::advance() {
 
   #endif // HAS_MEDIA
 
-  // The queue may be reset by a command handler or by code invoked by idle() within a handler
+  // The queue may be reset by a command handler or by code invoked by idle() within a handler.
+  // Then the command is already gone, and the slot may hold a newer one.
+  if (ring_buffer.generation != generation) return;
+
+  TERN_(COMMAND_ARENA, ring_buffer.peek_next_command().release());
   ring_buffer.advance_pos(ring_buffer.index_r, -1);
 }
 
@@ -28,8 +28,63 @@
 
 #include "../inc/MarlinConfig.h"
 
+#if ENABLED(PRETOKENIZED_GCODE)
+  #include "parser.h"
+#endif
+
 class GCodeQueue {
 public:
+  #if ENABLED(COMMAND_ARENA)
+    /**
+     * A byte ring where lines are assembled in place, then queued as views.
+     * Lines are always released in the order they were queued.
+     */
+    struct CommandArena {
+      char data[COMMAND_ARENA_SIZE];
+      uint16_t head,                //!< Start of the oldest queued line
+               tail,                //!< Start of the line being assembled
+               wrap;                //!< End of the lines queued before 'tail' wrapped around, or 0
+      uint8_t queued;               //!< Number of lines queued from this arena
+
+      // The line being assembled
+      char (&line())[MAX_CMD_SIZE] { return *reinterpret_cast<char (*)[MAX_CMD_SIZE]>(&data[tail]); }
+
+      /**
+       * Make sure there's room at 'tail' for a whole line, wrapping
+       * around if needed. Call only before the first character of a line.
+       */
+      bool reserve() {
+        if (!queued) { head = tail = wrap = 0; return true; }
+        if (wrap) return tail + (MAX_CMD_SIZE) <= head;
+        if (tail + (MAX_CMD_SIZE) <= (COMMAND_ARENA_SIZE)) return true;
+        if (head < (MAX_CMD_SIZE)) return false;
+        wrap = tail;
+        tail = 0;
+        return true;
+      }
+
+      // Queue the assembled line and return it
+      char* commit(const uint8_t len) {
+        char * const l = line();
+        tail += len + 1;
+        queued++;
+        return l;
+      }
+
+      // Release the oldest queued line. 'head' must follow even the last one,
+      // since a line may already be part-way assembled at 'tail'.
+      void release(const uint8_t len) {
+        if (!queued) return;
+        queued--;
+        head += len + 1;
+        if (head == wrap) head = wrap = 0;
+      }
+
+      // Drop all queued lines. A line being assembled stays where it is.
+      void reset() { head = tail; wrap = 0; queued = 0; }
+    };
+  #endif
+
   /**
    * The buffers per serial port.
    */
@@ -40,8 +95,17 @@ public:
      * M110 N<int> sets the current line number.
      */
     long last_N;
+    #if ENABLED(CREDIT_FLOW_CONTROL)
+      bool resend_pending;          //!< A resend was requested and the line hasn't come back yet
+    #endif
     int count;                      //!< Number of characters read in the current line of serial input
-    char line_buffer[MAX_CMD_SIZE]; //!< The current line accumulator
+    #if ENABLED(COMMAND_ARENA)
+      CommandArena arena;           //!< Lines are assembled and queued here
+      char (&line())[MAX_CMD_SIZE] { return arena.line(); }
+    #else
+      char line_buffer[MAX_CMD_SIZE]; //!< The current line accumulator
+      char (&line())[MAX_CMD_SIZE] { return line_buffer; }
+    #endif
     uint8_t input_state;            //!< The input state
   };
 
@@ -57,7 +121,17 @@ public:
    * command and hands off execution to individual handler functions.
    */
   struct CommandLine {
-    char buffer[MAX_CMD_SIZE];      //!< The command buffer
+    #if ENABLED(COMMAND_ARENA)
+      char *buffer;                 //!< The command, in place in its arena
+      CommandArena *arena;          //!< The arena holding the command
+      uint8_t length;               //!< Length of the command
+      void release() { arena->release(length); }
+    #else
+      char buffer[MAX_CMD_SIZE];    //!< The command buffer
+    #endif
+    #if ENABLED(PRETOKENIZED_GCODE)
+      parsed_command_t parsed;      //!< The command, parsed as it was queued
+    #endif
     bool skip_ok;                   //!< Skip sending ok when command is processed?
     #if HAS_MULTI_SERIAL
       serial_index_t port;          //!< Serial port the command was received on
@@ -70,12 +144,16 @@ public:
   struct RingBuffer {
     uint8_t length,                 //!< Number of commands in the queue
             index_r,                //!< Ring buffer's read position
-            index_w;                //!< Ring buffer's write position
+            index_w,                //!< Ring buffer's write position
+            generation;             //!< Changed by clear(), so advance() can tell its command is gone
     CommandLine commands[BUFSIZE];  //!< The ring buffer of commands
+    #if ENABLED(COMMAND_ARENA)
+      CommandArena arena;           //!< Arena for SD and internal commands
+    #endif
 
     inline serial_index_t command_port() const { return TERN0(HAS_MULTI_SERIAL, commands[index_r].port); }
 
-    inline void clear() { length = index_r = index_w = 0; }
+    inline void clear() { length = index_r = index_w = 0; generation++; TERN_(COMMAND_ARENA, arena.reset()); }
 
     void advance_pos(uint8_t &p, const int inc) { if (++p >= BUFSIZE) p = 0; length += inc; }
 
@@ -83,6 +161,13 @@ public:
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
     );
 
+    #if ENABLED(COMMAND_ARENA)
+      // Queue the line being assembled in the given arena
+      void commit_command(CommandArena &a, const uint8_t len, const bool skip_ok
+        OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
+      );
+    #endif
+
     bool enqueue(const char *cmd, const bool skip_ok=true
       OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind = serial_index_t())
     );
@@ -108,7 +193,12 @@ public:
   /**
    * Clear the Marlin command queue
    */
-  static void clear() { ring_buffer.clear(); }
+  static void clear() {
+    ring_buffer.clear();
+    #if ENABLED(COMMAND_ARENA)
+      for (uint8_t p = 0; p < NUM_SERIAL; ++p) serial_state[p].arena.reset();
+    #endif
+  }
 
   /**
    * Next Injected Command (PROGMEM) pointer. (nullptr == empty)
@@ -192,6 +282,9 @@ public:
    *   N<int>  Line number of the command, if any
    *   P<int>  Planner space remaining
    *   B<int>  Block queue space remaining
+   *
+   * If CREDIT_FLOW_CONTROL is enabled also include:
+   *   W<int>  Last line number the host may send for now
    */
   static void ok_to_send() { ring_buffer.ok_to_send(); }
 
@@ -210,7 +303,11 @@ public:
   /**
    * (Re)Set the current line number for the last received command
    */
-  static void set_current_line_number(long n) { serial_state[ring_buffer.command_port().index].last_N = n; }
+  static void set_current_line_number(long n) {
+    SerialState &serial = serial_state[ring_buffer.command_port().index];
+    serial.last_N = n;
+    TERN_(CREDIT_FLOW_CONTROL, serial.resend_pending = false);
+  }
 
   #if ENABLED(BUFFER_MONITORING)
 
@@ -0,0 +1,54 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(SDCARD_BLOCK_CACHE)
+
+#include "../gcode.h"
+#include "../../sd/cardreader.h"
+
+/**
+ * M963: SD block cache statistics
+ *
+ *   With no parameters, report the cache hits and misses for FAT and
+ *   directory blocks and for file data, and the blocks written back.
+ *
+ *   R : Reset the statistics
+ */
+void GcodeSuite::M963() {
+  cache_stats_t &stats = card.cacheStats();
+
+  if (parser.seen_test('R')) {
+    stats = {};
+    return;
+  }
+
+  SERIAL_ECHOLNPGM(
+    "SD cache FAT hits:", stats.hits[0], " misses:", stats.misses[0],
+    " data hits:", stats.hits[1], " misses:", stats.misses[1],
+    " writes:", stats.writes
+  );
+}
+
+#endif // SDCARD_BLOCK_CACHE
@@ -2552,6 +2552,52 @@ static_assert(COUNT(arm) == LOGICAL_AXES, "AXIS_RELATIVE_MODES must contain " _L
   #endif
 #endif
 
+#if ENABLED(SDCARD_COMPRESSED_GCODE) && !HAS_MEDIA
+  #error "SDCARD_COMPRESSED_GCODE requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+#endif
+
+#if ENABLED(SDCARD_READ_AHEAD)
+  #if !HAS_MEDIA
+    #error "SDCARD_READ_AHEAD requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+  #elif !WITHIN(SDCARD_READ_AHEAD_BLOCKS, 2, 16)
+    #error "SDCARD_READ_AHEAD_BLOCKS must be from 2 to 16."
+  #endif
+#endif
+
+#if ENABLED(SDCARD_BLOCK_CACHE)
+  #if !HAS_MEDIA
+    #error "SDCARD_BLOCK_CACHE requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+  #elif !WITHIN(SDCARD_CACHE_FAT_BLOCKS, 1, 8) || !WITHIN(SDCARD_CACHE_DATA_BLOCKS, 1, 8)
+    #error "SDCARD_CACHE_FAT_BLOCKS and SDCARD_CACHE_DATA_BLOCKS must be from 1 to 8."
+  #endif
+#endif
+
+#if ENABLED(SDCARD_FILE_EXTENTS)
+  #if !HAS_MEDIA
+    #error "SDCARD_FILE_EXTENTS requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+  #elif !WITHIN(SDCARD_FILE_EXTENTS_MAX, 1, 32)
+    #error "SDCARD_FILE_EXTENTS_MAX must be from 1 to 32."
+  #endif
+#endif
+
+#if ENABLED(SDCARD_DIR_INDEX)
+  #if !HAS_MEDIA
+    #error "SDCARD_DIR_INDEX requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+  #elif !WITHIN(SDCARD_DIR_INDEX_MAX, 16, 1024)
+    #error "SDCARD_DIR_INDEX_MAX must be from 16 to 1024."
+  #endif
+#endif
+
+#if ENABLED(SDCARD_WRITE_BEHIND)
+  #if !HAS_MEDIA
+    #error "SDCARD_WRITE_BEHIND requires SDSUPPORT or USB_FLASH_DRIVE_SUPPORT."
+  #elif ENABLED(SDCARD_READONLY)
+    #error "Either disable SDCARD_READONLY or disable SDCARD_WRITE_BEHIND."
+  #elif !WITHIN(SDCARD_WRITE_BEHIND_BLOCKS, 2, 16)
+    #error "SDCARD_WRITE_BEHIND_BLOCKS must be from 2 to 16."
+  #endif
+#endif
+
 /**
  * Make sure only one display is enabled
  */
@@ -3431,10 +3477,38 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
 
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "BLOCK_BUFFER_SIZE must be a power of 2."
-#elif BLOCK_BUFFER_SIZE > 64
+#elif BLOCK_BUFFER_SIZE > TERN(INCREMENTAL_PLANNER, 128, 64)
   #error "A very large BLOCK_BUFFER_SIZE is not needed and takes longer to drain the buffer on pause / cancel."
 #endif
 
+#if ENABLED(ADAPTIVE_LOOKAHEAD)
+  static_assert(LOOKAHEAD_MM > 0 && LOOKAHEAD_MS > 0, "LOOKAHEAD_MM and LOOKAHEAD_MS must be greater than 0.");
+  static_assert(WITHIN(LOOKAHEAD_MIN_BLOCKS, 1, BLOCK_BUFFER_SIZE - 2), "LOOKAHEAD_MIN_BLOCKS must be from 1 to BLOCK_BUFFER_SIZE - 2.");
+#endif
+
+#if ENABLED(COMMAND_ARENA)
+  static_assert(WITHIN(COMMAND_ARENA_SIZE, 2 * (MAX_CMD_SIZE), 65535), "COMMAND_ARENA_SIZE must be from 2 * MAX_CMD_SIZE to 65535.");
+  static_assert(MAX_CMD_SIZE <= 256, "COMMAND_ARENA requires a MAX_CMD_SIZE of 256 or less.");
+#endif
+
+#if ENABLED(PRETOKENIZED_GCODE)
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "PRETOKENIZED_GCODE requires FASTER_GCODE_PARSER."
+  #elif ENABLED(GCODE_MOTION_MODES)
+    #error "PRETOKENIZED_GCODE is not compatible with GCODE_MOTION_MODES."
+  #endif
+  static_assert(WITHIN(PRETOKENIZED_GCODE_VALUES, 1, 26), "PRETOKENIZED_GCODE_VALUES must be from 1 to 26.");
+  static_assert(MAX_CMD_SIZE <= 256, "PRETOKENIZED_GCODE requires a MAX_CMD_SIZE of 256 or less.");
+#endif
+
+#if ENABLED(SEGMENT_MERGE)
+  #if ENABLED(LASER_FEATURE)
+    #error "SEGMENT_MERGE is not compatible with LASER_FEATURE."
+  #endif
+  static_assert(SEGMENT_MERGE_TOLERANCE >= 0 && SEGMENT_MERGE_E_TOLERANCE >= 0, "SEGMENT_MERGE_TOLERANCE and SEGMENT_MERGE_E_TOLERANCE must be 0 or more.");
+  static_assert(WITHIN(SEGMENT_MERGE_MAX, 2, 255), "SEGMENT_MERGE_MAX must be from 2 to 255.");
+#endif
+
 #if ENABLED(LED_CONTROL_MENU) && NONE(HAS_MARLINUI_MENU, DWIN_LCD_PROUI)
   #error "LED_CONTROL_MENU requires an LCD controller that implements the menu."
 #endif
@@ -3824,6 +3898,42 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
   #error "Either enable MEATPACK_ON_SERIAL_PORT_* or BINARY_FILE_TRANSFER, not both."
 #endif
 
+/**
+ * Sanity Check for CREDIT_FLOW_CONTROL
+ */
+#if ENABLED(CREDIT_FLOW_CONTROL) && DISABLED(ADVANCED_OK)
+  #error "CREDIT_FLOW_CONTROL requires ADVANCED_OK."
+#endif
+
+/**
+ * Sanity Check for SERIAL_TX_QUEUE
+ */
+#if ENABLED(SERIAL_TX_QUEUE)
+  #if !WITHIN(SERIAL_TX_QUEUE_SIZE, 64, 32768) || !IS_POWER_OF_2(SERIAL_TX_QUEUE_SIZE)
+    #error "SERIAL_TX_QUEUE_SIZE must be a power of 2 from 64 to 32768."
+  #elif TX_BUFFER_SIZE < 16
+    #error "SERIAL_TX_QUEUE requires a TX_BUFFER_SIZE of at least 16."
+  #endif
+#endif
+
+/**
+ * Sanity Check for SERIAL_DMA
+ */
+#if ENABLED(SERIAL_DMA) && !defined(TARGET_HC32F46x)
+  #error "SERIAL_DMA is only supported on HC32F46x."
+#endif
+
+/**
+ * Sanity Check for BINARY_MOTION_STREAM
+ */
+#if ENABLED(BINARY_MOTION_STREAM)
+  #if DISABLED(BINARY_FILE_TRANSFER)
+    #error "BINARY_MOTION_STREAM requires BINARY_FILE_TRANSFER."
+  #elif ENABLED(LASER_FEATURE)
+    #error "BINARY_MOTION_STREAM is not compatible with LASER_FEATURE."
+  #endif
+#endif
+
 /**
  * Sanity Check for Slim LCD Menus and Probe Offset Wizard
  */
@@ -4096,10 +4206,22 @@ static_assert(_PLUS_TEST(3), "DEFAULT_MAX_ACCELERATION values must be positive."
 #if ALL(FT_MOTION, MIXING_EXTRUDER)
   #error "FT_MOTION does not currently support MIXING_EXTRUDER."
 #endif
+#if ENABLED(FT_MOTION)
+  static_assert(FTM_WINDOW_SIZE == 2 * (FTM_BATCH_SIZE), "FTM_WINDOW_SIZE must be twice FTM_BATCH_SIZE.");
+  static_assert(FTM_STEPS_PER_UNIT_TIME == (FTM_STEPPER_FS) / (FTM_FS), "FTM_STEPS_PER_UNIT_TIME must be (FTM_STEPPER_FS / FTM_FS).");
+  static_assert(FTM_CTS_COMPARE_VAL == (FTM_STEPS_PER_UNIT_TIME) / 2, "FTM_CTS_COMPARE_VAL must be (FTM_STEPS_PER_UNIT_TIME / 2).");
+  static_assert(FTM_STEPPERCMD_PREFILL < (FTM_STEPPERCMD_BUFF_SIZE) - (FTM_STEPS_PER_UNIT_TIME), "FTM_STEPPERCMD_PREFILL must be less than (FTM_STEPPERCMD_BUFF_SIZE - FTM_STEPS_PER_UNIT_TIME).");
+#endif
 
 // Multi-Stepping Limit
 static_assert(WITHIN(MULTISTEPPING_LIMIT, 1, 128) && IS_POWER_OF_2(MULTISTEPPING_LIMIT), "MULTISTEPPING_LIMIT must be 1, 2, 4, 8, 16, 32, 64, or 128.");
 
+// Step Compiler
+#if ENABLED(STEP_COMPILER)
+  static_assert(IS_POWER_OF_2(STEP_COMPILER_BLOCKS) && STEP_COMPILER_BLOCKS <= BLOCK_BUFFER_SIZE, "STEP_COMPILER_BLOCKS must be a power of 2 no larger than BLOCK_BUFFER_SIZE.");
+  static_assert(WITHIN(STEP_COMPILER_EVENTS, 1, 65535), "STEP_COMPILER_EVENTS must be between 1 and 65535.");
+#endif
+
 // One Click Print
 #if ENABLED(ONE_CLICK_PRINT)
   #if !HAS_MEDIA
@@ -4113,6 +4235,17 @@ static_assert(WITHIN(MULTISTEPPING_LIMIT, 1, 128) && IS_POWER_OF_2(MULTISTEPPING
   #endif
 #endif
 
+// Planner Benchmark
+#if ENABLED(PLANNER_BENCHMARK)
+  #if NONE(__PLAT_LINUX__, __PLAT_NATIVE_SIM__)
+    #error "PLANNER_BENCHMARK is only for native builds. (Blocks are never stepped.)"
+  #elif ENABLED(DIRECT_STEPPING)
+    #error "PLANNER_BENCHMARK is incompatible with DIRECT_STEPPING."
+  #elif ENABLED(FT_MOTION)
+    #error "PLANNER_BENCHMARK is incompatible with FT_MOTION."
+  #endif
+#endif
+
 // Misc. Cleanup
 #undef _TEST_PWM
 #undef _NUM_AXES_STR
@@ -41,9 +41,13 @@ struct AutoReporter {
     if (!report_interval) return;
     const millis_t ms = millis();
     if (ELAPSED(ms, next_report_ms)) {
-      next_report_ms = ms + SEC_TO_MS(report_interval);
       PORT_REDIRECT(report_port_mask);
-      Helper::report();
+      // Hold the report while older output is still queued, so reports never pile up.
+      // The one that goes out next has the latest values.
+      if (TERN1(SERIAL_TX_QUEUE, !serial_tx_pending())) {
+        next_report_ms = ms + SEC_TO_MS(report_interval);
+        Helper::report();
+      }
       PORT_RESTORE();
     }
   }
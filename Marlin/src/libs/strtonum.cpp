@@ -0,0 +1,97 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(FAST_NUMBER_PARSER)
+
+#include "strtonum.h"
+
+// Powers of ten that a float holds exactly
+static const float pow10f[] PROGMEM = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+/**
+ * Read the sign and digits of a number into a mantissa of up to 9
+ * significant digits and a power of ten. The mantissa is rounded at
+ * the first digit dropped. Dropped digits before the decimal point
+ * still count toward the power of ten.
+ */
+static bool dec_mantissa(const char *s, uint32_t &mant, int16_t &exp10) {
+  const bool neg = (*s == '-');
+  if (neg || *s == '+') ++s;
+
+  uint32_t m = 0;
+  int16_t e = 0;
+  uint8_t digits = 0;
+  auto add_digit = [&](const char c) {
+    if (digits < 9) {
+      m = m * 10 + (c - '0');
+      if (m) ++digits;            // Leading zeros aren't significant
+      return true;
+    }
+    if (digits++ == 9 && c >= '5') ++m;
+    return false;
+  };
+  for (; NUMERIC(*s); ++s) if (!add_digit(*s)) ++e;
+  if (*s == '.') for (++s; NUMERIC(*s); ++s) if (add_digit(*s)) --e;
+  mant = m;
+  exp10 = e;
+  return neg;
+}
+
+float dectof(const char *s) {
+  uint32_t m;
+  int16_t e;
+  const bool neg = dec_mantissa(s, m, e);
+
+  float f = m;                    // Exact below 2^24
+  if (m) {
+    // One multiply or divide by an exact power of ten is correctly rounded
+    for (; e < -10; e += 10) f /= pgm_read_float(&pow10f[10]);
+    for (; e > 10; e -= 10) f *= pgm_read_float(&pow10f[10]);
+    if (e < 0)
+      f /= pgm_read_float(&pow10f[-e]);
+    else if (e > 0)
+      f *= pgm_read_float(&pow10f[e]);
+  }
+  return neg ? -f : f;
+}
+
+int32_t dectofix(const char *s, const uint8_t places) {
+  const bool neg = (*s == '-');
+  if (neg || *s == '+') ++s;
+
+  // Take every digit up to the last decimal place, saturating at the int32 limit
+  uint32_t m = 0;
+  auto add_digit = [&](const char c) {
+    m = m > uint32_t(INT32_MAX - 9) / 10 ? uint32_t(INT32_MAX) : m * 10 + (c - '0');
+  };
+  for (; NUMERIC(*s); ++s) add_digit(*s);
+  uint8_t n = 0;
+  if (*s == '.') for (++s; n < places && NUMERIC(*s); ++s, ++n) add_digit(*s);
+  for (; n < places; ++n) add_digit('0');
+
+  if (*s >= '5' && *s <= '9' && m < uint32_t(INT32_MAX)) ++m;   // Round half away from zero
+  return neg ? -int32_t(m) : int32_t(m);
+}
+
+#endif // FAST_NUMBER_PARSER
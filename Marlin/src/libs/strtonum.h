@@ -0,0 +1,40 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2023 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * strtonum.h - Parse the decimal numbers used in G-code
+ *
+ * Numbers are [-+]?[0-9]*[.]?[0-9]* with no exponent, so parsing stops at
+ * 'E', 'X', or any other character. Up to 9 significant digits are used
+ * for float results. With 7 digits or fewer and up to 10 decimal places the
+ * result is the same as strtof. Otherwise it is within 1 ulp, or 2 ulp past
+ * 10 decimal places. Fixed-point results use every digit and are exact.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+// Convert a decimal number to float
+float dectof(const char *s);
+
+// Convert a decimal number to fixed point with the given decimal places, rounded to nearest
+int32_t dectofix(const char *s, const uint8_t places);
@@ -57,12 +57,16 @@ uint8_t FxdTiCtrl::stepperCmdBuff_ApplyDir[FTM_STEPPERCMD_DIR_SIZE] = {0U};
 uint32_t FxdTiCtrl::stepperCmdBuff_produceIdx = 0,  // Index of next stepper command write to the buffer.
          FxdTiCtrl::stepperCmdBuff_consumeIdx = 0;  // Index of next stepper command read from the buffer.
 
-bool FxdTiCtrl::sts_stepperBusy = false;          // The stepper buffer has items and is in use.
+volatile bool FxdTiCtrl::sts_stepperBusy = false; // The stepper buffer has items and is in use.
+volatile bool FxdTiCtrl::sts_producerBusy = false; // loop() still has commands to put in the buffer.
+bool FxdTiCtrl::stepperCmdBuff_filling = true;    // The Stepper ISR waits for the pre-fill watermark.
+ft_buff_stats_t FxdTiCtrl::buffStats = { 0, 0, FTM_STEPPERCMD_BUFF_SIZE }; // Command buffer statistics.
 
 // Private variables.
 // NOTE: These are sized for Ulendo FBS use.
 xyze_trajectory_t FxdTiCtrl::traj;                // = {0.0f} Storage for fixed-time-based trajectory.
 xyze_trajectoryMod_t FxdTiCtrl::trajMod;          // = {0.0f} Storage for modified fixed-time-based trajectory.
+xyze_trajectorySteps_t FxdTiCtrl::trajSteps;      // = {0} Step targets of the modified trajectory.
 
 block_t* FxdTiCtrl::current_block_cpy = nullptr;  // Pointer to current block being processed.
 bool FxdTiCtrl::blockProcRdy = false,             // Indicates a block is ready to be processed.
@@ -110,18 +114,22 @@ hal_timer_t FxdTiCtrl::nextStepTicks = FTM_MIN_TICKS; // Accumulator for the nex
 // Shaping variables.
 #if HAS_X_AXIS
   FxdTiCtrl::shaping_t FxdTiCtrl::shaping = {
-    0, 0,
+    0,
     x:{ { 0.0f }, { 0.0f }, { 0 } },                  // d_zi, Ai, Ni
     #if HAS_Y_AXIS
       y:{ { 0.0f }, { 0.0f }, { 0 } }                 // d_zi, Ai, Ni
     #endif
   };
+  #if HAS_DYNAMIC_FREQ
+    float FxdTiCtrl::dynFreqInput_z1 = 0.0f;          // Unit delay of the dynamic frequency input.
+  #endif
 #endif
 
 #if HAS_EXTRUDERS
   // Linear advance variables.
   float FxdTiCtrl::e_raw_z1 = 0.0f;             // (ms) Unit delay of raw extruder position.
   float FxdTiCtrl::e_advanced_z1 = 0.0f;        // (ms) Unit delay of advanced extruder position.
+  uint8_t FxdTiCtrl::blockExtruderAxis = E_AXIS; // Axis of the extruder for the block, kept for steps/mm after the block is released.
 #endif
 
 constexpr uint32_t last_batchIdx = (FTM_WINDOW_SIZE) - (FTM_BATCH_SIZE);
@@ -197,8 +205,8 @@ void FxdTiCtrl::loop() {
   }
 
   if (runout && !batchRdy) { // The lower half of the window has been runout.
-    // Runout the upper half of the window: the upper half has been shifted into the lower
-    // half. Fill out the upper half so another batch can be processed.
+    // Runout the upper half of the window: the last batch has been taken for processing.
+    // Fill out the upper half so another batch can be processed.
     for (uint32_t i = last_batchIdx; i < (FTM_WINDOW_SIZE) - 1; i++) {
       LOGICAL_AXIS_CODE(
         traj.e[i] = traj.e[(FTM_WINDOW_SIZE) - 1],
@@ -222,7 +230,7 @@ void FxdTiCtrl::loop() {
 
     // Call Ulendo FBS here.
 
-    // Copy the uncompensated vectors. (XY done, other axes uncompensated)
+    // Copy the uncompensated vectors.
     LOGICAL_AXIS_CODE(
       memcpy(trajMod.e, &traj.e[FTM_BATCH_SIZE], sizeof(trajMod.e)),
       memcpy(trajMod.x, &traj.x[FTM_BATCH_SIZE], sizeof(trajMod.x)),
@@ -236,14 +244,16 @@ void FxdTiCtrl::loop() {
       memcpy(trajMod.w, &traj.w[FTM_BATCH_SIZE], sizeof(trajMod.w))
     );
 
-    // Shift the time series back in the window for (shaped) X and Y
-    TERN_(HAS_X_AXIS, memcpy(traj.x, &traj.x[FTM_BATCH_SIZE], sizeof(traj.x) / 2));
-    TERN_(HAS_Y_AXIS, memcpy(traj.y, &traj.y[FTM_BATCH_SIZE], sizeof(traj.y) / 2));
+    // Shape X and Y over the whole batch. The shapers keep their own delay lines,
+    // so the lower half of the window is not used.
+    #if HAS_X_AXIS
+      if (cfg.modeHasShaper()) shapeBatch();
+    #endif
 
-    // Z...W and E Disabled! Uncompensated so the lower half is not used.
-    //TERN_(HAS_Z_AXIS, memcpy(&traj.z[0], &traj.z[FTM_BATCH_SIZE], sizeof(traj.z) / 2));
+    // Quantize the batch to step targets for interpolation.
+    batchToSteps();
 
-    // ... data is ready in trajMod.
+    // ... data is ready in trajMod and trajSteps.
     batchRdyForInterp = true;
 
     batchRdy = false; // Clear so that makeVector() may resume generating points.
@@ -263,8 +273,15 @@ void FxdTiCtrl::loop() {
     }
   }
 
+  const uint32_t items = stepperCmdBuffItems();
+  NOLESS(buffStats.highWater, items);
+
+  // Tell the Stepper ISR whether more commands are coming, so it only
+  // holds off for the pre-fill watermark while the buffer can still fill.
+  sts_producerBusy = ((!blockProcDn && blockProcRdy) || batchRdy || batchRdyForInterp || runoutEna);
+
   // Report busy status to planner.
-  planner.fxdTiCtrl_busy = (sts_stepperBusy || ((!blockProcDn && blockProcRdy) || batchRdy || batchRdyForInterp || runoutEna));
+  planner.fxdTiCtrl_busy = (sts_stepperBusy || sts_producerBusy || items);
 
   blockProcRdy_z1 = blockProcRdy;
   makeVector_idx_z1 = makeVector_idx;
@@ -353,33 +370,24 @@ void FxdTiCtrl::loop() {
   // To be called when frequencies change.
 
   void FxdTiCtrl::AxisShaping::updateShapingN(const_float_t f, const_float_t df) {
-    // Protections omitted for DBZ and for index exceeding array length.
+    // Half a period of the damped frequency, and the number of taps that far apart
+    float t;
+    uint32_t taps;
     switch (cfg.mode) {
-      case ftMotionMode_ZV:
-        Ni[1] = round((0.5f / f / df) * (FTM_FS));
-        break;
+      case ftMotionMode_ZV:   t = 0.5f;   taps = 1; break;
       case ftMotionMode_ZVD:
-      case ftMotionMode_EI:
-        Ni[1] = round((0.5f / f / df) * (FTM_FS));
-        Ni[2] = Ni[1] + Ni[1];
-        break;
-      case ftMotionMode_2HEI:
-        Ni[1] = round((0.5f / f / df) * (FTM_FS));
-        Ni[2] = Ni[1] + Ni[1];
-        Ni[3] = Ni[2] + Ni[1];
-        break;
-      case ftMotionMode_3HEI:
-        Ni[1] = round((0.5f / f / df) * (FTM_FS));
-        Ni[2] = Ni[1] + Ni[1];
-        Ni[3] = Ni[2] + Ni[1];
-        Ni[4] = Ni[3] + Ni[1];
-        break;
-      case ftMotionMode_MZV:
-        Ni[1] = round((0.375f / f / df) * (FTM_FS));
-        Ni[2] = Ni[1] + Ni[1];
-        break;
-      default: ZERO(Ni);
+      case ftMotionMode_EI:   t = 0.5f;   taps = 2; break;
+      case ftMotionMode_2HEI: t = 0.5f;   taps = 3; break;
+      case ftMotionMode_3HEI: t = 0.5f;   taps = 4; break;
+      case ftMotionMode_MZV:  t = 0.375f; taps = 2; break;
+      default: ZERO(Ni); return;
     }
+
+    // The delay line only holds FTM_ZMAX past points, so the last tap can go
+    // back no further. Lower frequencies are shaped as the lowest that fits.
+    uint32_t n = round((t / _MAX(f, FTM_MIN_SHAPE_FREQ) / df) * (FTM_FS));
+    NOMORE(n, uint32_t(FTM_ZMAX) / taps);
+    for (uint32_t i = 1U; i <= taps; i++) Ni[i] = n * i;
   }
 
   void FxdTiCtrl::updateShapingN(const_float_t xf OPTARG(HAS_Y_AXIS, const_float_t yf), const_float_t zeta/*=cfg.zeta*/) {
@@ -388,15 +396,113 @@ void FxdTiCtrl::loop() {
     TERN_(HAS_Y_AXIS, shaping.y.updateShapingN(yf, df));
   }
 
+  // Convolve one batch of data points with the shaper.
+  // The delay line holds FTM_ZMAX past points followed by the batch, so each
+  // tap is a multiply-accumulate over contiguous data with no index wrapping.
+
+  void FxdTiCtrl::AxisShaping::loadBatch(const float * const in) {
+    memcpy(&d_zi[FTM_ZMAX], in, sizeof(float) * (FTM_BATCH_SIZE));
+  }
+
+  // Shape points [from, to) of the batch with the current delay indices.
+  void FxdTiCtrl::AxisShaping::shape(float * const __restrict out, const uint32_t from, const uint32_t to, const uint32_t max_i) {
+    const float * const d = &d_zi[FTM_ZMAX];
+
+    const float A0 = Ai[0];
+    for (uint32_t n = from; n < to; n++) out[n] = A0 * d[n];
+
+    for (uint32_t i = 1U; i <= max_i; i++) {
+      const float A = Ai[i];
+      const float * const __restrict dz = d - Ni[i];
+      for (uint32_t n = from; n < to; n++) out[n] += A * dz[n];
+    }
+  }
+
+  // Keep the newest points as history for the next batch.
+  void FxdTiCtrl::AxisShaping::keepHistory() {
+    memmove(d_zi, &d_zi[FTM_BATCH_SIZE], sizeof(float) * (FTM_ZMAX));
+  }
+
+  void FxdTiCtrl::shapeRun(const uint32_t from, const uint32_t to) {
+    shaping.x.shape(trajMod.x, from, to, shaping.max_i);
+    TERN_(HAS_Y_AXIS, shaping.y.shape(trajMod.y, from, to, shaping.max_i));
+  }
+
+  void FxdTiCtrl::shapeBatch() {
+    shaping.x.loadBatch(&traj.x[FTM_BATCH_SIZE]);
+    TERN_(HAS_Y_AXIS, shaping.y.loadBatch(&traj.y[FTM_BATCH_SIZE]));
+
+    uint32_t from = 0U;
+    #if HAS_DYNAMIC_FREQ
+      // The frequency follows every data point. Shape each run of points
+      // with the same delay indices at once, then switch to the new ones.
+      for (uint32_t n = 0U; n < (FTM_BATCH_SIZE); n++) {
+        const float v = dynFreqInput(n);
+        if (v == dynFreqInput_z1) continue; // Only update if the input changed.
+        shapeRun(from, n);
+        updateDynamicFreq(v);
+        dynFreqInput_z1 = v;
+        from = n;
+      }
+    #endif
+    shapeRun(from, FTM_BATCH_SIZE);
+
+    shaping.x.keepHistory();
+    TERN_(HAS_Y_AXIS, shaping.y.keepHistory());
+  }
+
+  #if HAS_DYNAMIC_FREQ
+
+    // The trajectory value that sets the shaping frequency at a point of the batch.
+    float FxdTiCtrl::dynFreqInput(const uint32_t n) {
+      switch (cfg.dynFreqMode) {
+        #if HAS_DYNAMIC_FREQ_MM
+          case dynFreqMode_Z_BASED: return traj.z[FTM_BATCH_SIZE + n];
+        #endif
+        #if HAS_DYNAMIC_FREQ_G
+          case dynFreqMode_MASS_BASED: return traj.e[FTM_BATCH_SIZE + n];
+        #endif
+        default: return 0.0f;
+      }
+    }
+
+    // Update shaping parameters for a new input value.
+    void FxdTiCtrl::updateDynamicFreq(const_float_t v) {
+      switch (cfg.dynFreqMode) {
+
+        #if HAS_DYNAMIC_FREQ_MM
+          case dynFreqMode_Z_BASED: {
+            const float xf = cfg.baseFreq[X_AXIS] + cfg.dynFreqK[X_AXIS] * v,
+                        yf = cfg.baseFreq[Y_AXIS] + cfg.dynFreqK[Y_AXIS] * v;
+            updateShapingN(_MAX(xf, FTM_MIN_SHAPE_FREQ), _MAX(yf, FTM_MIN_SHAPE_FREQ));
+          } break;
+        #endif
+
+        #if HAS_DYNAMIC_FREQ_G
+          case dynFreqMode_MASS_BASED:
+            // E is expected to change constantly, so this usually shapes one point at a time.
+            updateShapingN(      cfg.baseFreq[X_AXIS] + cfg.dynFreqK[X_AXIS] * v
+              OPTARG(HAS_Y_AXIS, cfg.baseFreq[Y_AXIS] + cfg.dynFreqK[Y_AXIS] * v) );
+            break;
+        #endif
+
+        default: break;
+      }
+    }
+
+  #endif // HAS_DYNAMIC_FREQ
+
 #endif // HAS_X_AXIS
 
 // Reset all trajectory processing variables.
 void FxdTiCtrl::reset() {
 
   stepperCmdBuff_produceIdx = stepperCmdBuff_consumeIdx = 0;
+  stepperCmdBuff_filling = true;
 
   traj.reset(); // Reset trajectory history
   trajMod.reset(); // Reset modified trajectory history
+  trajSteps.reset(); // Reset step targets
 
   blockProcRdy = blockProcRdy_z1 = blockProcDn = false;
   batchRdy = batchRdyForInterp = false;
@@ -414,9 +520,9 @@ void FxdTiCtrl::reset() {
   nextStepTicks = FTM_MIN_TICKS;
 
   #if HAS_X_AXIS
-    for (uint32_t i = 0U; i < (FTM_ZMAX); i++)
-      shaping.x.d_zi[i] = TERN_(HAS_Y_AXIS, shaping.y.d_zi[i] =) 0.0f;
-    shaping.zi_idx = 0;
+    ZERO(shaping.x.d_zi);
+    TERN_(HAS_Y_AXIS, ZERO(shaping.y.d_zi));
+    refreshShapingN(); // Drop any dynamic frequency along with the history
   #endif
 
   TERN_(HAS_EXTRUDERS, e_raw_z1 = e_advanced_z1 = 0.0f);
@@ -425,8 +531,9 @@ void FxdTiCtrl::reset() {
 // Private functions.
 // Auxiliary function to get number of step commands in the buffer.
 uint32_t FxdTiCtrl::stepperCmdBuffItems() {
-  const uint32_t udiff = stepperCmdBuff_produceIdx - stepperCmdBuff_consumeIdx;
-  return stepperCmdBuff_produceIdx < stepperCmdBuff_consumeIdx ? (FTM_STEPPERCMD_BUFF_SIZE) + udiff : udiff;
+  const uint32_t c = __atomic_load_n(&stepperCmdBuff_consumeIdx, __ATOMIC_ACQUIRE),
+                 udiff = stepperCmdBuff_produceIdx - c;
+  return stepperCmdBuff_produceIdx < c ? (FTM_STEPPERCMD_BUFF_SIZE) + udiff : udiff;
 }
 
 // Initializes storage variables before startup.
@@ -446,6 +553,8 @@ void FxdTiCtrl::loadBlockData(block_t * const current_block) {
 
   const AxisBits direction = current_block->direction_bits;
 
+  TERN_(HAS_EXTRUDERS, blockExtruderAxis = E_AXIS_N(current_block->extruder));
+
   startPosn = endPosn_prevBlock;
   xyze_pos_t moveDist = LOGICAL_AXIS_ARRAY(
     current_block->steps.e / planner.settings.axis_steps_per_mm[E_AXIS_N(current_block->extruder)],
@@ -587,57 +696,7 @@ void FxdTiCtrl::makeVector() {
     }
   #endif
 
-  // Update shaping parameters if needed.
-  #if HAS_DYNAMIC_FREQ_MM
-    static float zd_z1 = 0.0f;
-  #endif
-  switch (cfg.dynFreqMode) {
-
-    #if HAS_DYNAMIC_FREQ_MM
-      case dynFreqMode_Z_BASED:
-        if (traj.z[makeVector_batchIdx] != zd_z1) { // Only update if Z changed.
-          const float xf = cfg.baseFreq[X_AXIS] + cfg.dynFreqK[X_AXIS] * traj.z[makeVector_batchIdx],
-                      yf = cfg.baseFreq[Y_AXIS] + cfg.dynFreqK[Y_AXIS] * traj.z[makeVector_batchIdx];
-          updateShapingN(_MAX(xf, FTM_MIN_SHAPE_FREQ), _MAX(yf, FTM_MIN_SHAPE_FREQ));
-          zd_z1 = traj.z[makeVector_batchIdx];
-        }
-        break;
-    #endif
-
-    #if HAS_DYNAMIC_FREQ_G
-      case dynFreqMode_MASS_BASED:
-        // Update constantly. The optimization done for Z value makes
-        // less sense for E, as E is expected to constantly change.
-        updateShapingN(      cfg.baseFreq[X_AXIS] + cfg.dynFreqK[X_AXIS] * traj.e[makeVector_batchIdx]
-          OPTARG(HAS_Y_AXIS, cfg.baseFreq[Y_AXIS] + cfg.dynFreqK[Y_AXIS] * traj.e[makeVector_batchIdx]) );
-        break;
-    #endif
-
-    default: break;
-  }
-
-  // Apply shaping if in mode.
-  #if HAS_X_AXIS
-    if (cfg.modeHasShaper()) {
-      shaping.x.d_zi[shaping.zi_idx] = traj.x[makeVector_batchIdx];
-      traj.x[makeVector_batchIdx] *= shaping.x.Ai[0];
-      #if HAS_Y_AXIS
-        shaping.y.d_zi[shaping.zi_idx] = traj.y[makeVector_batchIdx];
-        traj.y[makeVector_batchIdx] *= shaping.y.Ai[0];
-      #endif
-      for (uint32_t i = 1U; i <= shaping.max_i; i++) {
-        const uint32_t udiffx = shaping.zi_idx - shaping.x.Ni[i];
-        traj.x[makeVector_batchIdx] += shaping.x.Ai[i] * shaping.x.d_zi[shaping.x.Ni[i] > shaping.zi_idx ? (FTM_ZMAX) + udiffx : udiffx];
-        #if HAS_Y_AXIS
-          const uint32_t udiffy = shaping.zi_idx - shaping.y.Ni[i];
-          traj.y[makeVector_batchIdx] += shaping.y.Ai[i] * shaping.y.d_zi[shaping.y.Ni[i] > shaping.zi_idx ? (FTM_ZMAX) + udiffy : udiffy];
-        #endif
-      }
-      if (++shaping.zi_idx == (FTM_ZMAX)) shaping.zi_idx = 0;
-    }
-  #endif
-
-  // Filled up the queue with regular and shaped steps
+  // Filled up the batch. Shaping is applied to the whole batch in loop().
   if (++makeVector_batchIdx == (FTM_WINDOW_SIZE)) {
     makeVector_batchIdx = last_batchIdx;
     batchRdy = true;
@@ -652,51 +711,48 @@ void FxdTiCtrl::makeVector() {
     makeVector_idx++;
 }
 
+// Converts the batch of data points to step targets, one axis at a time.
+void FxdTiCtrl::batchToSteps() {
+  auto QUANTIZE = [](int32_t * const __restrict s, const float * const __restrict p, const float spm) {
+    //#define STEPS_ROUNDING
+    for (uint32_t n = 0U; n < (FTM_BATCH_SIZE); n++)
+      #if ENABLED(STEPS_ROUNDING)
+        s[n] = int32_t(p[n] * spm + (p[n] < 0.0f ? -0.5f : 0.5f));
+      #else
+        s[n] = int32_t(p[n] * spm);
+      #endif
+  };
+
+  LOGICAL_AXIS_CODE(
+    QUANTIZE(trajSteps.e, trajMod.e, planner.settings.axis_steps_per_mm[blockExtruderAxis]),
+    QUANTIZE(trajSteps.x, trajMod.x, planner.settings.axis_steps_per_mm[X_AXIS]),
+    QUANTIZE(trajSteps.y, trajMod.y, planner.settings.axis_steps_per_mm[Y_AXIS]),
+    QUANTIZE(trajSteps.z, trajMod.z, planner.settings.axis_steps_per_mm[Z_AXIS]),
+    QUANTIZE(trajSteps.i, trajMod.i, planner.settings.axis_steps_per_mm[I_AXIS]),
+    QUANTIZE(trajSteps.j, trajMod.j, planner.settings.axis_steps_per_mm[J_AXIS]),
+    QUANTIZE(trajSteps.k, trajMod.k, planner.settings.axis_steps_per_mm[K_AXIS]),
+    QUANTIZE(trajSteps.u, trajMod.u, planner.settings.axis_steps_per_mm[U_AXIS]),
+    QUANTIZE(trajSteps.v, trajMod.v, planner.settings.axis_steps_per_mm[V_AXIS]),
+    QUANTIZE(trajSteps.w, trajMod.w, planner.settings.axis_steps_per_mm[W_AXIS])
+  );
+}
+
 // Interpolates single data point to stepper commands.
 void FxdTiCtrl::convertToSteps(const uint32_t idx) {
   xyze_long_t err_P = { 0 };
 
-  //#define STEPS_ROUNDING
-  #if ENABLED(STEPS_ROUNDING)
-    const xyze_float_t steps_tar = LOGICAL_AXIS_ARRAY(
-      trajMod.e[idx] * planner.settings.axis_steps_per_mm[E_AXIS_N(current_block->extruder)] + (trajMod.e[idx] < 0.0f ? -0.5f : 0.5f), // May be eliminated if guaranteed positive.
-      trajMod.x[idx] * planner.settings.axis_steps_per_mm[X_AXIS] + (trajMod.x[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.y[idx] * planner.settings.axis_steps_per_mm[Y_AXIS] + (trajMod.y[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.z[idx] * planner.settings.axis_steps_per_mm[Z_AXIS] + (trajMod.z[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.i[idx] * planner.settings.axis_steps_per_mm[I_AXIS] + (trajMod.i[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.j[idx] * planner.settings.axis_steps_per_mm[J_AXIS] + (trajMod.j[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.k[idx] * planner.settings.axis_steps_per_mm[K_AXIS] + (trajMod.k[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.u[idx] * planner.settings.axis_steps_per_mm[U_AXIS] + (trajMod.u[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.v[idx] * planner.settings.axis_steps_per_mm[V_AXIS] + (trajMod.v[idx] < 0.0f ? -0.5f : 0.5f),
-      trajMod.w[idx] * planner.settings.axis_steps_per_mm[W_AXIS] + (trajMod.w[idx] < 0.0f ? -0.5f : 0.5f),
-    );
-    xyze_long_t delta = xyze_long_t(steps_tar) - steps;
-    //const xyze_long_t delta = LOGICAL_AXIS_ARRAY(
-    //  int32_t(steps_tar.e) - steps.e,
-    //  int32_t(steps_tar.x) - steps.x,
-    //  int32_t(steps_tar.y) - steps.y,
-    //  int32_t(steps_tar.z) - steps.z,
-    //  int32_t(steps_tar.i) - steps.i,
-    //  int32_t(steps_tar.j) - steps.j,
-    //  int32_t(steps_tar.k) - steps.k,
-    //  int32_t(steps_tar.u) - steps.u,
-    //  int32_t(steps_tar.v) - steps.v,
-    //  int32_t(steps_tar.w) - steps.w
-    //);
-  #else
-    xyze_long_t delta = LOGICAL_AXIS_ARRAY(
-      int32_t(trajMod.e[idx] * planner.settings.axis_steps_per_mm[E_AXIS_N(current_block->extruder)]) - steps.e,
-      int32_t(trajMod.x[idx] * planner.settings.axis_steps_per_mm[X_AXIS]) - steps.x,
-      int32_t(trajMod.y[idx] * planner.settings.axis_steps_per_mm[Y_AXIS]) - steps.y,
-      int32_t(trajMod.z[idx] * planner.settings.axis_steps_per_mm[Z_AXIS]) - steps.z,
-      int32_t(trajMod.i[idx] * planner.settings.axis_steps_per_mm[I_AXIS]) - steps.i,
-      int32_t(trajMod.j[idx] * planner.settings.axis_steps_per_mm[J_AXIS]) - steps.j,
-      int32_t(trajMod.k[idx] * planner.settings.axis_steps_per_mm[K_AXIS]) - steps.k,
-      int32_t(trajMod.u[idx] * planner.settings.axis_steps_per_mm[U_AXIS]) - steps.u,
-      int32_t(trajMod.v[idx] * planner.settings.axis_steps_per_mm[V_AXIS]) - steps.v,
-      int32_t(trajMod.w[idx] * planner.settings.axis_steps_per_mm[W_AXIS]) - steps.w
-    );
-  #endif
+  const xyze_long_t delta = LOGICAL_AXIS_ARRAY(
+    trajSteps.e[idx] - steps.e,
+    trajSteps.x[idx] - steps.x,
+    trajSteps.y[idx] - steps.y,
+    trajSteps.z[idx] - steps.z,
+    trajSteps.i[idx] - steps.i,
+    trajSteps.j[idx] - steps.j,
+    trajSteps.k[idx] - steps.k,
+    trajSteps.u[idx] - steps.u,
+    trajSteps.v[idx] - steps.v,
+    trajSteps.w[idx] - steps.w
+  );
 
   bool any_dirChange = (false
     LOGICAL_AXIS_GANG(
@@ -799,10 +855,11 @@ void FxdTiCtrl::convertToSteps(const uint32_t idx) {
         CBI(stepperCmdBuff_ApplyDir[dir_index], dir_bit);
       }
 
-      if (stepperCmdBuff_produceIdx == (FTM_STEPPERCMD_BUFF_SIZE) - 1)
-        stepperCmdBuff_produceIdx = 0;
-      else
-        stepperCmdBuff_produceIdx++;
+      // Publish the command to the Stepper ISR.
+      __atomic_store_n(&stepperCmdBuff_produceIdx,
+        stepperCmdBuff_produceIdx == (FTM_STEPPERCMD_BUFF_SIZE) - 1 ? 0 : stepperCmdBuff_produceIdx + 1,
+        __ATOMIC_RELEASE
+      );
 
       nextStepTicks = FTM_MIN_TICKS;
     }
@@ -64,6 +64,13 @@ typedef struct FTConfig {
   #endif
 } ft_config_t;
 
+typedef struct FTBuffStats {
+  uint32_t underruns,                                       // Times the command buffer ran dry while commands were still being produced.
+           highWater,                                       // Most commands ever queued.
+           lowWater;                                        // Fewest commands queued when the Stepper ISR took one.
+  void reset() { underruns = highWater = 0; lowWater = FTM_STEPPERCMD_BUFF_SIZE; }
+} ft_buff_stats_t;
+
 class FxdTiCtrl {
 
   public:
@@ -101,10 +108,46 @@ class FxdTiCtrl {
     static ft_command_t stepperCmdBuff[FTM_STEPPERCMD_BUFF_SIZE];               // Buffer of stepper commands.
     static hal_timer_t stepperCmdBuff_StepRelativeTi[FTM_STEPPERCMD_BUFF_SIZE]; // Buffer of the stepper command timing.
     static uint8_t stepperCmdBuff_ApplyDir[FTM_STEPPERCMD_DIR_SIZE];            // Buffer of whether DIR needs to be updated.
+    // The command buffer is a single-producer / single-consumer ring. Only loop() writes
+    // the produce index and only the Stepper ISR writes the consume index. Each side
+    // fills or reads the slots first, then publishes its index with release ordering,
+    // and reads the other side's index with acquire ordering.
     static uint32_t stepperCmdBuff_produceIdx,              // Index of next stepper command write to the buffer.
                     stepperCmdBuff_consumeIdx;              // Index of next stepper command read from the buffer.
 
-    static bool sts_stepperBusy;                            // The stepper buffer has items and is in use.
+    static volatile bool sts_stepperBusy;                   // The stepper buffer has items and is in use.
+    static volatile bool sts_producerBusy;                  // loop() still has commands to put in the buffer.
+    static bool stepperCmdBuff_filling;                     // The Stepper ISR waits for the pre-fill watermark.
+    static ft_buff_stats_t buffStats;                       // Command buffer statistics.
+
+    // Take one command from the buffer, to be called from the Stepper ISR.
+    // Once the buffer runs dry, hold off until FTM_STEPPERCMD_PREFILL commands
+    // are queued again, or until loop() has nothing more to add.
+    static bool stepperCmdBuffPop(ft_command_t &cmd, bool &applyDir, hal_timer_t &ticks) {
+      const uint32_t c = stepperCmdBuff_consumeIdx,
+                     p = __atomic_load_n(&stepperCmdBuff_produceIdx, __ATOMIC_ACQUIRE),
+                     items = p < c ? (FTM_STEPPERCMD_BUFF_SIZE) + p - c : p - c;
+
+      if (!items) {
+        if (!stepperCmdBuff_filling && sts_producerBusy) buffStats.underruns++;
+        stepperCmdBuff_filling = true;
+        return false;
+      }
+
+      if (stepperCmdBuff_filling) {
+        if (items < (FTM_STEPPERCMD_PREFILL) && sts_producerBusy) return false;
+        stepperCmdBuff_filling = false;
+      }
+      else if (sts_producerBusy)
+        NOMORE(buffStats.lowWater, items);
+
+      cmd = stepperCmdBuff[c];
+      applyDir = TEST(stepperCmdBuff_ApplyDir[c >> 3], c & 0x7);
+      ticks = stepperCmdBuff_StepRelativeTi[c];
+
+      __atomic_store_n(&stepperCmdBuff_consumeIdx, c == (FTM_STEPPERCMD_BUFF_SIZE) - 1 ? 0 : c + 1, __ATOMIC_RELEASE);
+      return true;
+    }
 
 
     // Public methods
@@ -124,7 +167,11 @@ class FxdTiCtrl {
       // To be called when frequencies change.
       static void updateShapingN(const_float_t xf OPTARG(HAS_Y_AXIS, const_float_t yf), const_float_t zeta=cfg.zeta);
 
-      static void refreshShapingN() { updateShapingN(cfg.baseFreq[X_AXIS] OPTARG(HAS_Y_AXIS, cfg.baseFreq[Y_AXIS])); }
+      // Set the base frequencies, which are also the ones for a dynamic frequency input of 0
+      static void refreshShapingN() {
+        updateShapingN(cfg.baseFreq[X_AXIS] OPTARG(HAS_Y_AXIS, cfg.baseFreq[Y_AXIS]));
+        TERN_(HAS_DYNAMIC_FREQ, dynFreqInput_z1 = 0.0f);
+      }
 
     #endif
 
@@ -134,6 +181,7 @@ class FxdTiCtrl {
 
     static xyze_trajectory_t traj;
     static xyze_trajectoryMod_t trajMod;
+    static xyze_trajectorySteps_t trajSteps;
 
     static block_t *current_block_cpy;
     static bool blockProcRdy, blockProcRdy_z1, blockProcDn;
@@ -171,17 +219,19 @@ class FxdTiCtrl {
     #if HAS_X_AXIS
 
       typedef struct AxisShaping {
-        float d_zi[FTM_ZMAX] = { 0.0f };  // Data point delay vector.
+        float d_zi[(FTM_ZMAX) + (FTM_BATCH_SIZE)] = { 0.0f }; // Data point delay line: FTM_ZMAX past points, then the batch.
         float Ai[5];                      // Shaping gain vector.
         uint32_t Ni[5];                   // Shaping time index vector.
 
         void updateShapingN(const_float_t f, const_float_t df);
+        void loadBatch(const float * const in);
+        void shape(float * const __restrict out, const uint32_t from, const uint32_t to, const uint32_t max_i);
+        void keepHistory();
 
       } axis_shaping_t;
 
       typedef struct Shaping {
-        uint32_t zi_idx,           // Index of storage in the data point delay vectors.
-                 max_i;            // Vector length for the selected shaper.
+        uint32_t max_i;            // Vector length for the selected shaper.
         axis_shaping_t x;
         #if HAS_Y_AXIS
           axis_shaping_t y;
@@ -193,17 +243,31 @@ class FxdTiCtrl {
 
       static shaping_t shaping; // Shaping data
 
+      #if HAS_DYNAMIC_FREQ
+        static float dynFreqInput_z1; // Dynamic frequency input the shaping indices were last set for
+      #endif
+
     #endif // HAS_X_AXIS
 
     // Linear advance variables.
     #if HAS_EXTRUDERS
       static float e_raw_z1, e_advanced_z1;
+      static uint8_t blockExtruderAxis;
     #endif
 
     // Private methods
     static uint32_t stepperCmdBuffItems();
     static void loadBlockData(block_t * const current_block);
     static void makeVector();
+    #if HAS_X_AXIS
+      #if HAS_DYNAMIC_FREQ
+        static float dynFreqInput(const uint32_t n);
+        static void updateDynamicFreq(const_float_t v);
+      #endif
+      static void shapeRun(const uint32_t from, const uint32_t to);
+      static void shapeBatch();
+    #endif
+    static void batchToSteps();
     static void convertToSteps(const uint32_t idx);
 
 }; // class fxdTiCtrl
@@ -50,6 +50,7 @@ enum stepDirState_t : uint8_t {
 
 typedef struct XYZEarray<float, FTM_WINDOW_SIZE> xyze_trajectory_t;
 typedef struct XYZEarray<float, FTM_BATCH_SIZE> xyze_trajectoryMod_t;
+typedef struct XYZEarray<int32_t, FTM_BATCH_SIZE> xyze_trajectorySteps_t;
 
 typedef struct XYZEval<stepDirState_t> xyze_stepDir_t;
 
@@ -82,6 +82,10 @@
   #include "../feature/bedlevel/bdl/bdl.h"
 #endif
 
+#if ENABLED(SEGMENT_MERGE)
+  #include "../feature/segment_merge.h"
+#endif
+
 // Relative Mode. Enable with G91, disable with G90.
 bool relative_mode; // = false;
 
@@ -395,6 +399,7 @@ void home_if_needed(const bool keeplev/*=false*/) {
  * position from the last-updated stepper positions.
  */
 void quickstop_stepper() {
+  TERN_(SEGMENT_MERGE, segment_merge.discard());
   planner.quick_stop();
   planner.synchronize();
   set_current_from_steppers_for_axis(ALL_AXES_ENUM);
@@ -113,6 +113,14 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(PLANNER_BENCHMARK)
+  #include "../feature/planner_benchmark.h"
+#endif
+
+#if ENABLED(SEGMENT_MERGE)
+  #include "../feature/segment_merge.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_NONE         0U
@@ -130,6 +138,14 @@ volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
                  Planner::block_buffer_tail;    // Index of the busy block, if any
+#if ENABLED(INCREMENTAL_PLANNER)
+  uint8_t Planner::block_buffer_frontier;       // Index where the last reverse pass stopped
+#endif
+#if ENABLED(ADAPTIVE_LOOKAHEAD)
+  uint8_t Planner::lookahead_tail;              // Index of the oldest block counted in the look-ahead
+  float Planner::lookahead_mm,                  // Length of the non-busy moves in the buffer
+        Planner::lookahead_s;                   // Nominal duration of the non-busy moves in the buffer
+#endif
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // Delay block delivery so initial blocks in an empty queue may merge
 
@@ -726,6 +742,30 @@ void Planner::init() {
 
 #define MINIMAL_STEP_RATE 120
 
+#if ENABLED(FIXED_POINT_TRAPEZOIDS)
+
+  // Division with hardware 32-bit math when the dividend is small enough, as it usually is
+  FORCE_INLINE static uint32_t udiv64_32(const uint64_t n, const uint32_t d) {
+    return (n >> 32) ? uint32_t(n / d) : uint32_t(n) / d;
+  }
+
+  #if ANY(S_CURVE_ACCELERATION, LIN_ADVANCE)
+    // Integer square root, rounded down
+    template<typename T>
+    static T _isqrt(T x) {
+      T r = 0, b = T(1) << (sizeof(T) * 8 - 2);
+      while (b > x) b >>= 2;
+      for (; b; b >>= 2) {
+        if (x >= r + b) { x -= r + b; r = (r >> 1) + b; }
+        else r >>= 1;
+      }
+      return r;
+    }
+    static uint32_t isqrt(const uint64_t x) { return (x >> 32) ? uint32_t(_isqrt<uint64_t>(x)) : _isqrt<uint32_t>(uint32_t(x)); }
+  #endif
+
+#endif
+
 /**
  * Get the current block for processing
  * and mark the block as busy.
@@ -735,6 +775,9 @@ void Planner::init() {
  * WARNING: Called from Stepper ISR context!
  */
 block_t* Planner::get_current_block() {
+  // Benchmark blocks are retired by the planner, never stepped
+  if (ENABLED(PLANNER_BENCHMARK)) return nullptr;
+
   // Get the number of moves in the planner queue so far
   const uint8_t nr_moves = movesplanned();
 
@@ -806,45 +849,98 @@ void Planner::calculate_trapezoid_for_block(block_t * const block, const_float_t
            decelerate_steps = 0;
 
   const int32_t accel = block->acceleration_steps_per_s2;
-  float inverse_accel = 0.0f;
-  if (accel != 0) {
-    inverse_accel = 1.0f / accel;
-    const float half_inverse_accel = 0.5f * inverse_accel,
-                nominal_rate_sq = sq(float(block->nominal_rate)),
-                // Steps required for acceleration, deceleration to/from nominal rate
-                decelerate_steps_float = half_inverse_accel * (nominal_rate_sq - sq(float(final_rate)));
-          float accelerate_steps_float = half_inverse_accel * (nominal_rate_sq - sq(float(initial_rate)));
-    accelerate_steps = CEIL(accelerate_steps_float);
-    decelerate_steps = FLOOR(decelerate_steps_float);
-
-    // Steps between acceleration and deceleration, if any
-    plateau_steps -= accelerate_steps + decelerate_steps;
-
-    // Does accelerate_steps + decelerate_steps exceed step_event_count?
-    // Then we can't possibly reach the nominal rate, there will be no cruising.
-    // Calculate accel / braking time in order to reach the final_rate exactly
-    // at the end of this block.
-    if (plateau_steps < 0) {
-      accelerate_steps_float = CEIL((block->step_event_count + accelerate_steps_float - decelerate_steps_float) * 0.5f);
-      accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
-      decelerate_steps = block->step_event_count - accelerate_steps;
-
-      #if ANY(S_CURVE_ACCELERATION, LIN_ADVANCE)
-        // We won't reach the cruising rate. Let's calculate the speed we will reach
-        cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
-      #endif
+
+  #if ENABLED(FIXED_POINT_TRAPEZOIDS)
+
+    // Integer equivalent of the float math below. The results are exact, so they
+    // may differ from float by a step. Rate squares need 64 bits above 65535 steps/s.
+    if (accel != 0) {
+      const uint32_t accel_x2 = uint32_t(accel) * 2;
+      const uint64_t nominal_rate_sq = sq(uint64_t(block->nominal_rate)),
+                     initial_rate_sq = sq(uint64_t(initial_rate)),
+                     final_rate_sq = sq(uint64_t(final_rate));
+
+      // Steps required for acceleration, deceleration to/from nominal rate: (v1^2 - v0^2) / 2a
+      if (nominal_rate_sq > initial_rate_sq)
+        accelerate_steps = udiv64_32(nominal_rate_sq - initial_rate_sq + accel_x2 - 1, accel_x2);
+      if (nominal_rate_sq > final_rate_sq)
+        decelerate_steps = udiv64_32(nominal_rate_sq - final_rate_sq, accel_x2);
+
+      // Steps between acceleration and deceleration, if any
+      plateau_steps -= accelerate_steps + decelerate_steps;
+
+      // No cruising. Meet in the middle, so the final_rate is reached exactly
+      // at the end of this block: (2a * steps + final_rate^2 - initial_rate^2) / 4a
+      if (plateau_steps < 0) {
+        const uint64_t dist = uint64_t(accel_x2) * block->step_event_count + final_rate_sq;
+        accelerate_steps = dist > initial_rate_sq
+          ? _MIN(udiv64_32(dist - initial_rate_sq + accel_x2 * 2 - 1, accel_x2 * 2), block->step_event_count)
+          : 0;
+        decelerate_steps = block->step_event_count - accelerate_steps;
+
+        #if ANY(S_CURVE_ACCELERATION, LIN_ADVANCE)
+          // We won't reach the cruising rate. Let's calculate the speed we will reach
+          cruise_rate = isqrt(initial_rate_sq + uint64_t(accel_x2) * accelerate_steps);
+        #endif
+      }
     }
-  }
 
-  #if ENABLED(S_CURVE_ACCELERATION)
-    const float rate_factor = inverse_accel * (STEPPER_TIMER_RATE);
-    // Jerk controlled speed requires to express speed versus time, NOT steps
-    uint32_t acceleration_time = rate_factor * float(cruise_rate - initial_rate),
-             deceleration_time = rate_factor * float(cruise_rate - final_rate),
-    // And to offload calculations from the ISR, we also calculate the inverse of those times here
-             acceleration_time_inverse = get_period_inverse(acceleration_time),
-             deceleration_time_inverse = get_period_inverse(deceleration_time);
-  #endif
+    #if ENABLED(S_CURVE_ACCELERATION)
+      // Timer ticks to change between two rates. Zero if the phase is empty.
+      auto rate_change_time = [&](const uint32_t from, const uint32_t to) -> uint32_t {
+        return (accel && to > from) ? udiv64_32(uint64_t(to - from) * (STEPPER_TIMER_RATE), accel) : 0;
+      };
+      // Jerk controlled speed requires to express speed versus time, NOT steps
+      uint32_t acceleration_time = rate_change_time(initial_rate, cruise_rate),
+               deceleration_time = rate_change_time(final_rate, cruise_rate),
+      // And to offload calculations from the ISR, we also calculate the inverse of those times here
+               acceleration_time_inverse = get_period_inverse(acceleration_time),
+               deceleration_time_inverse = get_period_inverse(deceleration_time);
+    #endif
+
+  #else // !FIXED_POINT_TRAPEZOIDS
+
+    float inverse_accel = 0.0f;
+    if (accel != 0) {
+      inverse_accel = 1.0f / accel;
+      const float half_inverse_accel = 0.5f * inverse_accel,
+                  nominal_rate_sq = sq(float(block->nominal_rate)),
+                  // Steps required for acceleration, deceleration to/from nominal rate
+                  decelerate_steps_float = half_inverse_accel * (nominal_rate_sq - sq(float(final_rate)));
+            float accelerate_steps_float = half_inverse_accel * (nominal_rate_sq - sq(float(initial_rate)));
+      accelerate_steps = CEIL(accelerate_steps_float);
+      decelerate_steps = FLOOR(decelerate_steps_float);
+
+      // Steps between acceleration and deceleration, if any
+      plateau_steps -= accelerate_steps + decelerate_steps;
+
+      // Does accelerate_steps + decelerate_steps exceed step_event_count?
+      // Then we can't possibly reach the nominal rate, there will be no cruising.
+      // Calculate accel / braking time in order to reach the final_rate exactly
+      // at the end of this block.
+      if (plateau_steps < 0) {
+        accelerate_steps_float = CEIL((block->step_event_count + accelerate_steps_float - decelerate_steps_float) * 0.5f);
+        accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
+        decelerate_steps = block->step_event_count - accelerate_steps;
+
+        #if ANY(S_CURVE_ACCELERATION, LIN_ADVANCE)
+          // We won't reach the cruising rate. Let's calculate the speed we will reach
+          cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
+        #endif
+      }
+    }
+
+    #if ENABLED(S_CURVE_ACCELERATION)
+      const float rate_factor = inverse_accel * (STEPPER_TIMER_RATE);
+      // Jerk controlled speed requires to express speed versus time, NOT steps
+      uint32_t acceleration_time = rate_factor * float(cruise_rate - initial_rate),
+               deceleration_time = rate_factor * float(cruise_rate - final_rate),
+      // And to offload calculations from the ISR, we also calculate the inverse of those times here
+               acceleration_time_inverse = get_period_inverse(acceleration_time),
+               deceleration_time_inverse = get_period_inverse(deceleration_time);
+    #endif
+
+  #endif // !FIXED_POINT_TRAPEZOIDS
 
   // Store new block parameters
   block->accelerate_until = accelerate_steps;
@@ -1044,6 +1140,8 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
  * Once in reverse and once forward. This implements the reverse pass.
  */
 void Planner::reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Timer bench(PB_REVERSE_PASS));
+
   // Initialize block index to the last block in the planner buffer.
   uint8_t block_index = prev_block_index(block_buffer_head);
 
@@ -1068,6 +1166,17 @@ void Planner::reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_
     // Only process movement blocks
     if (current->is_move()) {
       reverse_pass_kernel(current, next OPTARG(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
+      TERN_(PLANNER_BENCHMARK, planner_bench.touched(PB_REVERSE_PASS));
+
+      #if ENABLED(INCREMENTAL_PLANNER)
+        // The entry speed of this block didn't change, so no older block can
+        // change either. Leave the frontier here for the forward pass.
+        if (!current->flag.recalculate) {
+          block_buffer_frontier = block_index;
+          return;
+        }
+      #endif
+
       next = current;
     }
 
@@ -1142,6 +1251,7 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
  * Once in reverse and once forward. This implements the forward pass.
  */
 void Planner::forward_pass() {
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Timer bench(PB_FORWARD_PASS));
 
   // Forward Pass: Forward plan the acceleration curve from the planned pointer onward.
   // Also scans for optimal plan breakpoints and appropriately updates the planned pointer.
@@ -1152,6 +1262,12 @@ void Planner::forward_pass() {
   //  pass will never modify the values at the tail.
   uint8_t block_index = block_buffer_planned;
 
+  #if ENABLED(INCREMENTAL_PLANNER)
+    // Skip the blocks the reverse pass found to be unchanged
+    if (BLOCK_MOD(block_buffer_frontier - block_index) < BLOCK_MOD(block_buffer_head - block_index))
+      block_index = block_buffer_frontier;
+  #endif
+
   block_t *block;
   const block_t * previous = nullptr;
   while (block_index != block_buffer_head) {
@@ -1168,6 +1284,7 @@ void Planner::forward_pass() {
       // updating the exit speed of the previous block).
       if (!previous || !stepper.is_block_busy(previous))
         forward_pass_kernel(previous, block, block_index);
+      TERN_(PLANNER_BENCHMARK, planner_bench.touched(PB_FORWARD_PASS));
       previous = block;
     }
     // Advance to the previous
@@ -1181,9 +1298,19 @@ void Planner::forward_pass() {
  * recalculate() after updating the blocks.
  */
 void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Timer bench(PB_TRAPEZOIDS));
+
   // The tail may be changed by the ISR so get a local copy.
   uint8_t block_index = block_buffer_tail,
           head_block_index = block_buffer_head;
+
+  #if ENABLED(INCREMENTAL_PLANNER)
+    // Blocks before the frontier have final entry and exit speeds. Start one
+    // block early in case the block at the frontier was the newest last time.
+    const uint8_t first_index = prev_block_index(block_buffer_frontier);
+    if (BLOCK_MOD(first_index - block_index) < BLOCK_MOD(head_block_index - block_index))
+      block_index = first_index;
+  #endif
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
@@ -1211,6 +1338,7 @@ void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t
 
     // Only process movement blocks
     if (next->is_move()) {
+      TERN_(PLANNER_BENCHMARK, planner_bench.touched(PB_TRAPEZOIDS));
       next_entry_speed = SQRT(next->entry_speed_sqr);
 
       if (block) {
@@ -1274,6 +1402,8 @@ void Planner::recalculate_trapezoids(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t
 void Planner::recalculate(TERN_(HINTS_SAFE_EXIT_SPEED, const_float_t safe_exit_speed_sqr)) {
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
+  // Without an early stop in the reverse pass all blocks after 'planned' are revisited
+  TERN_(INCREMENTAL_PLANNER, block_buffer_frontier = block_buffer_planned);
   // If there is just one block, no planning can be done. Avoid it!
   if (block_index != block_buffer_planned) {
     reverse_pass(TERN_(HINTS_SAFE_EXIT_SPEED, safe_exit_speed_sqr));
@@ -1676,6 +1806,28 @@ void Planner::check_axes_activity() {
 
 #endif
 
+#if ENABLED(ADAPTIVE_LOOKAHEAD)
+
+  /**
+   * Subtract the blocks the Stepper has started since the last call.
+   * Only the main thread changes the look-ahead totals, so the ISR
+   * just has to advance block_buffer_nonbusy.
+   */
+  void Planner::update_lookahead() {
+    const uint8_t nonbusy = block_buffer_nonbusy;
+    if (nonbusy == block_buffer_head) return clear_lookahead();
+    while (lookahead_tail != nonbusy) {
+      block_t * const block = &block_buffer[lookahead_tail];
+      if (block->is_move()) {
+        lookahead_mm -= block->millimeters;
+        lookahead_s -= block->millimeters / block->nominal_speed;
+      }
+      lookahead_tail = next_block_index(lookahead_tail);
+    }
+  }
+
+#endif
+
 void Planner::quick_stop() {
 
   // Remove all the queued blocks. Note that this function is NOT
@@ -1688,6 +1840,7 @@ void Planner::quick_stop() {
 
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
+  TERN_(ADAPTIVE_LOOKAHEAD, clear_lookahead());
 
   // Restart the block delay for the first movement - As the queue was
   // forced to empty, there's no risk the ISR will touch this.
@@ -1743,6 +1896,7 @@ bool Planner::busy() {
 }
 
 void Planner::finish_and_disable() {
+  TERN_(PLANNER_BENCHMARK, while (bench_retire_block()) { /* drain */ });
   while (has_blocks_queued() || cleaning_buffer_counter) idle();
   stepper.disable_all_steppers();
 }
@@ -1803,7 +1957,42 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 /**
  * Block until the planner is finished processing
  */
-void Planner::synchronize() { while (busy()) idle(); }
+void Planner::synchronize() {
+  TERN_(SEGMENT_MERGE, segment_merge.flush());
+  TERN_(PLANNER_BENCHMARK, while (bench_retire_block()) { /* drain */ });
+  while (busy()) idle();
+}
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+  /**
+   * Retire the oldest block as if the Stepper ISR had run it to completion.
+   * Keeps the look-ahead window full while the benchmark streams G-code.
+   * Return false if there is nothing that can be retired.
+   */
+  bool Planner::bench_retire_block() {
+    if (!has_blocks_queued()) return false;
+
+    block_t * const block = &block_buffer[block_buffer_tail];
+    if (block->flag.recalculate) return false;
+
+    TERN_(HAS_WIRED_LCD, block_buffer_runtime_us -= block->segment_time_us);
+
+    // Same bookkeeping as get_current_block + release_current_block
+    block_buffer_nonbusy = next_block_index(block_buffer_tail);
+    if (block_buffer_tail == block_buffer_planned)
+      block_buffer_planned = block_buffer_nonbusy;
+    release_current_block();
+    planner_bench.block_retired();
+    if (planner_bench.trace) planner_bench.trace_block(block);
+
+    // Nothing was stepped, so sync the steppers once the queue drains
+    if (!has_blocks_queued()) stepper.set_position(position);
+
+    return true;
+  }
+
+#endif
 
 /**
  * @brief Add a new linear movement to the planner queue (in terms of steps).
@@ -1857,9 +2046,16 @@ bool Planner::_buffer_steps(const xyze_long_t &target
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  #if ENABLED(ADAPTIVE_LOOKAHEAD)
+    lookahead_mm += block->millimeters;
+    lookahead_s += block->millimeters / block->nominal_speed;
+  #endif
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate(TERN_(HINTS_SAFE_EXIT_SPEED, hints.safe_exit_speed_sqr));
 
+  TERN_(PLANNER_BENCHMARK, planner_bench.block_planned());
+
   // Movement successfully queued!
   return true;
 }
@@ -1887,6 +2083,8 @@ bool Planner::_populate_block(
   OPTARG(HAS_DIST_MM_ARG, const xyze_float_t &cart_dist_mm)
   , feedRate_t fr_mm_s, const uint8_t extruder, const PlannerHints &hints
 ) {
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Timer bench(PB_POPULATE));
+
   xyze_long_t dist = target - position;
 
   /* <-- add a slash to enable
@@ -2894,6 +3092,7 @@ bool Planner::_populate_block(
  * @param sync_flag  The sync flag to set, determining the type of sync the block will do
  */
 void Planner::buffer_sync_block(const BlockFlagBit sync_flag/*=BLOCK_BIT_SYNC_POSITION*/) {
+  TERN_(SEGMENT_MERGE, segment_merge.flush());
 
   // Wait for the next available block
   uint8_t next_buffer_head;
@@ -2953,9 +3152,23 @@ bool Planner::buffer_segment(const abce_pos_t &abce
   , const PlannerHints &hints/*=PlannerHints()*/
 ) {
 
+  // Plan a move held for merging first, so moves and position changes stay in order
+  TERN_(SEGMENT_MERGE, segment_merge.flush());
+
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
+  #if ENABLED(ADAPTIVE_LOOKAHEAD)
+    // Hold off while the queued moves already cover enough distance and time
+    if (lookahead_full()) {
+      do {
+        if (TERN0(PLANNER_BENCHMARK, bench_retire_block())) continue;
+        idle();
+      } while (lookahead_full());
+      if (cleaning_buffer_counter) return false;
+    }
+  #endif
+
   // When changing extruders recalculate steps corresponding to the E position
   #if ENABLED(DISTINCT_E_FACTORS)
     if (last_extruder != extruder && settings.axis_steps_per_mm[E_AXIS_N(extruder)] != settings.axis_steps_per_mm[E_AXIS_N(last_extruder)]) {
@@ -3077,6 +3290,9 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
   , const uint8_t extruder/*=active_extruder*/
   , const PlannerHints &hints/*=PlannerHints()*/
 ) {
+  TERN_(SEGMENT_MERGE, segment_merge.flush());
+  TERN_(PLANNER_BENCHMARK, const PlannerBenchmark::Timer bench(PB_BUFFER_LINE));
+
   xyze_pos_t machine = cart;
   TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine));
 
@@ -3178,6 +3394,7 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
 #if ENABLED(DIRECT_STEPPING)
 
   void Planner::buffer_page(const page_idx_t page_idx, const uint8_t extruder, const uint16_t num_steps) {
+    TERN_(SEGMENT_MERGE, segment_merge.flush());
     if (!last_page_step_rate) {
       kill(GET_TEXT_F(MSG_BAD_PAGE_SPEED));
       return;
@@ -3236,6 +3453,7 @@ bool Planner::buffer_line(const xyze_pos_t &cart, const_feedRate_t fr_mm_s
  * The provided ABCE position is in machine units.
  */
 void Planner::set_machine_position_mm(const abce_pos_t &abce) {
+  TERN_(SEGMENT_MERGE, segment_merge.flush());
   TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
   TERN_(HAS_POSITION_FLOAT, position_float = abce);
   position.set(
@@ -3270,6 +3488,7 @@ void Planner::set_machine_position_mm(const abce_pos_t &abce) {
 }
 
 void Planner::set_position_mm(const xyze_pos_t &xyze) {
+  TERN_(SEGMENT_MERGE, segment_merge.flush());
   xyze_pos_t machine = xyze;
   TERN_(HAS_POSITION_MODIFIERS, apply_modifiers(machine, true));
   #if IS_KINEMATIC
@@ -3288,6 +3507,7 @@ void Planner::set_position_mm(const xyze_pos_t &xyze) {
    * Setters for planner position (also setting stepper position).
    */
   void Planner::set_e_position_mm(const_float_t e) {
+    TERN_(SEGMENT_MERGE, segment_merge.flush());
     const uint8_t axis_index = E_AXIS_N(active_extruder);
     TERN_(DISTINCT_E_FACTORS, last_extruder = active_extruder);
 
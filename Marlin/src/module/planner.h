@@ -423,6 +423,14 @@ class Planner {
                             block_buffer_nonbusy,   // Index of the first non busy block
                             block_buffer_planned,   // Index of the optimally planned block
                             block_buffer_tail;      // Index of the busy block, if any
+    #if ENABLED(INCREMENTAL_PLANNER)
+      static uint8_t block_buffer_frontier;         // Index where the last reverse pass found an unchanged entry speed
+    #endif
+    #if ENABLED(ADAPTIVE_LOOKAHEAD)
+      static uint8_t lookahead_tail;                // Index of the oldest block counted in the look-ahead
+      static float lookahead_mm,                    // Length of the non-busy moves in the buffer
+                   lookahead_s;                     // Nominal duration of the non-busy moves in the buffer
+    #endif
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
@@ -778,7 +786,26 @@ class Planner {
     FORCE_INLINE static uint8_t nonbusy_movesplanned() { return BLOCK_MOD(block_buffer_head - block_buffer_nonbusy); }
 
     // Remove all blocks from the buffer
-    FORCE_INLINE static void clear_block_buffer() { block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0; }
+    FORCE_INLINE static void clear_block_buffer() {
+      block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail = 0;
+      TERN_(ADAPTIVE_LOOKAHEAD, clear_lookahead());
+    }
+
+    #if ENABLED(ADAPTIVE_LOOKAHEAD)
+      // Forget the look-ahead, as when the buffer is emptied
+      FORCE_INLINE static void clear_lookahead() { lookahead_tail = block_buffer_head; lookahead_mm = lookahead_s = 0; }
+
+      // Take blocks the Stepper has started out of the look-ahead
+      static void update_lookahead();
+
+      // Does the buffer already hold enough moves, by distance and by time?
+      static bool lookahead_full() {
+        update_lookahead();
+        return nonbusy_movesplanned() >= (LOOKAHEAD_MIN_BLOCKS)
+            && lookahead_mm >= (LOOKAHEAD_MM)
+            && lookahead_s >= (LOOKAHEAD_MS) * 0.001f;
+      }
+    #endif
 
     // Check if movement queue is full
     FORCE_INLINE static bool is_full() { return block_buffer_tail == next_block_index(block_buffer_head); }
@@ -795,8 +822,15 @@ class Planner {
      */
     FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
 
+      // Blocks must leave the look-ahead before their slots are reused
+      TERN_(ADAPTIVE_LOOKAHEAD, update_lookahead());
+
       // Wait until there are enough slots free
-      while (moves_free() < count) { idle(); }
+      while (moves_free() < count) {
+        // The benchmark frees up space without waiting for the Stepper
+        if (TERN0(PLANNER_BENCHMARK, bench_retire_block())) continue;
+        idle();
+      }
 
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
@@ -969,6 +1003,11 @@ class Planner {
     // Block until all buffered steps are executed / cleaned
     static void synchronize();
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      // Retire the oldest block without stepping it
+      static bool bench_retire_block();
+    #endif
+
     // Wait for moves to finish and disable all steppers
     static void finish_and_disable();
 
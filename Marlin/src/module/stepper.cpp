@@ -146,6 +146,10 @@ Stepper stepper; // Singleton
   #include "../HAL/ESP32/i2s.h"
 #endif
 
+#if ENABLED(STEPPER_ISR_STATS)
+  #include "../feature/stepper_isr_stats.h"
+#endif
+
 // public:
 
 #if ANY(HAS_EXTRA_ENDSTOPS, Z_STEPPER_AUTO_ALIGN)
@@ -209,6 +213,11 @@ uint32_t Stepper::acceleration_time, Stepper::deceleration_time;
 
 IF_DISABLED(ADAPTIVE_STEP_SMOOTHING, constexpr) uint8_t Stepper::oversampling_factor;
 
+#if ENABLED(STEP_COMPILER)
+  const step_table_t *Stepper::step_table; // = nullptr
+  uint16_t Stepper::step_table_event;      // = 0
+#endif
+
 xyze_long_t Stepper::delta_error{0};
 
 xyze_long_t Stepper::advance_dividend{0};
@@ -1516,26 +1525,15 @@ void Stepper::isr() {
               fxdTiCtrl_stepper(fxdTiCtrl_applyDir, fxdTiCtrl_stepCmd);
               fxdTiCtrl_stepCmdRdy = false;
             }
-            // Check if there is data in the buffers.
-            if (fxdTiCtrl.stepperCmdBuff_produceIdx != fxdTiCtrl.stepperCmdBuff_consumeIdx) {
-
+            // "Pop" one command from the command buffer, if there is data in the buffers.
+            if (fxdTiCtrl.stepperCmdBuffPop(fxdTiCtrl_stepCmd, fxdTiCtrl_applyDir, nextMainISR)) {
               fxdTiCtrl.sts_stepperBusy = true;
-
-              // "Pop" one command from the command buffer.
-              fxdTiCtrl_stepCmd = fxdTiCtrl.stepperCmdBuff[fxdTiCtrl.stepperCmdBuff_consumeIdx];
-              const uint8_t dir_index = fxdTiCtrl.stepperCmdBuff_consumeIdx >> 3,
-                            dir_bit = fxdTiCtrl.stepperCmdBuff_consumeIdx & 0x7;
-              fxdTiCtrl_applyDir = TEST(fxdTiCtrl.stepperCmdBuff_ApplyDir[dir_index], dir_bit);
-              nextMainISR = fxdTiCtrl.stepperCmdBuff_StepRelativeTi[fxdTiCtrl.stepperCmdBuff_consumeIdx];
               fxdTiCtrl_stepCmdRdy = true;
-
-              if (++fxdTiCtrl.stepperCmdBuff_consumeIdx == (FTM_STEPPERCMD_BUFF_SIZE))
-                fxdTiCtrl.stepperCmdBuff_consumeIdx = 0;
-
             }
-            else { // Buffer empty.
+            else { // Buffer empty or still filling.
               fxdTiCtrl.sts_stepperBusy = false;
-              nextMainISR = 0.01f * (STEPPER_TIMER_RATE); // Come back in 10 msec.
+              // Come back in 1 msec if commands are on the way, otherwise 10 msec.
+              nextMainISR = (fxdTiCtrl.sts_producerBusy ? 0.001f : 0.01f) * (STEPPER_TIMER_RATE);
             }
           } // !(abort_current_block)
         } // if (!nextMainISR)
@@ -1698,6 +1696,9 @@ void Stepper::isr() {
   // Now 'next_isr_ticks' contains the period to the next Stepper ISR - And we are
   // sure that the time has not arrived yet - Warrantied by the scheduler
 
+  // Time since the timer fired, including the ISR entry
+  TERN_(STEPPER_ISR_STATS, StepperISRStats::record(ISR_TOTAL, HAL_timer_get_count(MF_TIMER_STEP)));
+
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(MF_TIMER_STEP, next_isr_ticks);
 
@@ -1723,6 +1724,7 @@ void Stepper::isr() {
  * is to keep pulse timing as regular as possible.
  */
 void Stepper::pulse_phase_isr() {
+  TERN_(STEPPER_ISR_STATS, const StepperISRStats::Timer isr_timer(ISR_PULSE));
 
   // If we must abort the current block, do so!
   if (abort_current_block) {
@@ -1941,49 +1943,69 @@ void Stepper::pulse_phase_isr() {
     #endif // DIRECT_STEPPING
 
     if (!is_page) {
-      // Give the compiler a clue to store advance_divisor in registers for what follows
-      const uint32_t advance_divisor_cached = advance_divisor;
-
-      // Determine if pulses are needed
-      #if HAS_X_STEP
-        PULSE_PREP(X);
-      #endif
-      #if HAS_Y_STEP
-        PULSE_PREP(Y);
-      #endif
-      #if HAS_Z_STEP
-        PULSE_PREP(Z);
-      #endif
-      #if HAS_I_STEP
-        PULSE_PREP(I);
-      #endif
-      #if HAS_J_STEP
-        PULSE_PREP(J);
-      #endif
-      #if HAS_K_STEP
-        PULSE_PREP(K);
-      #endif
-      #if HAS_U_STEP
-        PULSE_PREP(U);
-      #endif
-      #if HAS_V_STEP
-        PULSE_PREP(V);
-      #endif
-      #if HAS_W_STEP
-        PULSE_PREP(W);
+      #if ENABLED(STEP_COMPILER) && DISABLED(STEP_COMPILER_CHECK)
+        if (step_table) {
+          // Steppers to step on this event, compiled ahead of time
+          step_needed = step_table->event[step_table_event];
+          if (++step_table_event >= step_table->events) {
+            // The line tracer resumes where the table ends
+            delta_error = step_table->delta_error;
+            step_table = nullptr;
+          }
+        }
+        else
       #endif
+      {
+        // Give the compiler a clue to store advance_divisor in registers for what follows
+        const uint32_t advance_divisor_cached = advance_divisor;
 
-      #if ANY(HAS_E0_STEP, MIXING_EXTRUDER)
-        PULSE_PREP(E);
+        // Determine if pulses are needed
+        #if HAS_X_STEP
+          PULSE_PREP(X);
+        #endif
+        #if HAS_Y_STEP
+          PULSE_PREP(Y);
+        #endif
+        #if HAS_Z_STEP
+          PULSE_PREP(Z);
+        #endif
+        #if HAS_I_STEP
+          PULSE_PREP(I);
+        #endif
+        #if HAS_J_STEP
+          PULSE_PREP(J);
+        #endif
+        #if HAS_K_STEP
+          PULSE_PREP(K);
+        #endif
+        #if HAS_U_STEP
+          PULSE_PREP(U);
+        #endif
+        #if HAS_V_STEP
+          PULSE_PREP(V);
+        #endif
+        #if HAS_W_STEP
+          PULSE_PREP(W);
+        #endif
 
-        #if ENABLED(LIN_ADVANCE)
-          if (la_active && step_needed.e) {
-            // don't actually step here, but do subtract movements steps
-            // from the linear advance step count
-            step_needed.e = false;
-            la_advance_steps--;
-          }
+        #if ANY(HAS_E0_STEP, MIXING_EXTRUDER)
+          PULSE_PREP(E);
         #endif
+      }
+
+      #if ENABLED(STEP_COMPILER_CHECK)
+        // Step from the live line tracer and count the table entries that differ
+        if (step_table && !StepCompiler::check(*step_table, step_table_event++, step_needed, delta_error))
+          step_table = nullptr;
+      #endif
+
+      #if ENABLED(LIN_ADVANCE) && ANY(HAS_E0_STEP, MIXING_EXTRUDER)
+        if (la_active && step_needed.e) {
+          // don't actually step here, but do subtract movements steps
+          // from the linear advance step count
+          step_needed.e = false;
+          la_advance_steps--;
+        }
       #endif
 
       #if HAS_ZV_SHAPING
@@ -2103,6 +2125,7 @@ void Stepper::pulse_phase_isr() {
 #if HAS_ZV_SHAPING
 
   void Stepper::shaping_isr() {
+    TERN_(STEPPER_ISR_STATS, const StepperISRStats::Timer isr_timer(ISR_SHAPING));
     AxisFlags step_needed{0};
 
     // Clear the echoes that are ready to process. If the buffers are too full and risk overflow, also apply echoes early.
@@ -2255,6 +2278,8 @@ hal_timer_t Stepper::calc_multistep_timer_interval(uint32_t step_rate) {
  * have been done, so it is less time critical.
  */
 hal_timer_t Stepper::block_phase_isr() {
+  TERN_(STEPPER_ISR_STATS, const StepperISRStats::Timer isr_timer(ISR_BLOCK));
+
   #if DISABLED(OLD_ADAPTIVE_MULTISTEPPING)
     // If the ISR uses < 50% of MPU time, halve multi-stepping
     const hal_timer_t time_spent = HAL_timer_get_count(MF_TIMER_STEP);
@@ -2635,18 +2660,8 @@ hal_timer_t Stepper::block_phase_isr() {
       // No acceleration / deceleration time elapsed so far
       acceleration_time = deceleration_time = 0;
 
-      #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
-        oversampling_factor = 0;                            // Assume no axis smoothing (via oversampling)
-        // Decide if axis smoothing is possible
-        uint32_t max_rate = current_block->nominal_rate;    // Get the step event rate
-        if (TERN1(DWIN_LCD_PROUI, hmiData.adaptiveStepSmoothing)) {
-          while (max_rate < MIN_STEP_ISR_FREQUENCY) {       // As long as more ISRs are possible...
-            max_rate <<= 1;                                 // Try to double the rate
-            if (max_rate < MIN_STEP_ISR_FREQUENCY)          // Don't exceed the estimated ISR limit
-              ++oversampling_factor;                        // Increase the oversampling (used for left-shift)
-          }
-        }
-      #endif
+      // Decide if axis smoothing is possible
+      TERN_(ADAPTIVE_STEP_SMOOTHING, oversampling_factor = calc_oversampling(current_block->nominal_rate));
 
       // Based on the oversampling factor, do the calculations
       step_event_count = current_block->step_event_count << oversampling_factor;
@@ -2658,6 +2673,12 @@ hal_timer_t Stepper::block_phase_isr() {
       advance_dividend = (current_block->steps << 1).asLong();
       advance_divisor = step_event_count << 1;
 
+      #if ENABLED(STEP_COMPILER)
+        // Read the step events from a table, if one was compiled for this block
+        step_table = current_block->is_page() ? nullptr : StepCompiler::table_for(current_block - planner.block_buffer, current_block, step_event_count);
+        step_table_event = 0;
+      #endif
+
       #if ENABLED(INPUT_SHAPING_X)
         if (shaping_x.enabled) {
           const int64_t steps = current_block->direction_bits.x ? int64_t(current_block->steps.x) : -int64_t(current_block->steps.x);
@@ -2776,6 +2797,8 @@ hal_timer_t Stepper::block_phase_isr() {
 
   // Timer interrupt for E. LA_steps is set in the main routine
   void Stepper::advance_isr() {
+    TERN_(STEPPER_ISR_STATS, const StepperISRStats::Timer isr_timer(ISR_ADVANCE));
+
     // Apply Bresenham algorithm so that linear advance can piggy back on
     // the acceleration and speed values calculated in block_phase_isr().
     // This helps keep LA in sync with, for example, S_CURVE_ACCELERATION.
@@ -2811,12 +2834,29 @@ hal_timer_t Stepper::block_phase_isr() {
 
   // Timer interrupt for baby-stepping
   hal_timer_t Stepper::babystepping_isr() {
+    TERN_(STEPPER_ISR_STATS, const StepperISRStats::Timer isr_timer(ISR_BABYSTEP));
     babystep.task();
     return babystep.has_steps() ? BABYSTEP_TICKS : BABYSTEP_NEVER;
   }
 
 #endif
 
+#if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+
+  uint8_t Stepper::calc_oversampling(uint32_t max_rate) {
+    uint8_t oversampling = 0;                           // Assume no axis smoothing (via oversampling)
+    if (TERN1(DWIN_LCD_PROUI, hmiData.adaptiveStepSmoothing)) {
+      while (max_rate < MIN_STEP_ISR_FREQUENCY) {       // As long as more ISRs are possible...
+        max_rate <<= 1;                                 // Try to double the rate
+        if (max_rate < MIN_STEP_ISR_FREQUENCY)          // Don't exceed the estimated ISR limit
+          ++oversampling;                               // Increase the oversampling (used for left-shift)
+      }
+    }
+    return oversampling;
+  }
+
+#endif
+
 // Check if the given block is busy or not - Must not be called from ISR contexts
 // The current_block could change in the middle of the read by an Stepper ISR, so
 // we must explicitly prevent that!
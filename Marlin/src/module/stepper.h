@@ -54,6 +54,10 @@
   #include "ft_types.h"
 #endif
 
+#if ENABLED(STEP_COMPILER)
+  #include "../feature/step_compiler.h"
+#endif
+
 // TODO: Review and ensure proper handling for special E axes with commands like M17/M18, stepper timeout, etc.
 #if ENABLED(MIXING_EXTRUDER)
   #define E_STATES EXTRUDERS  // All steppers are set together for each mixer. (Currently limited to 1.)
@@ -290,6 +294,7 @@ constexpr ena_mask_t enable_overlap[] = {
 class Stepper {
   friend class Max7219;
   friend class FxdTiCtrl;
+  friend class StepCompiler;
   friend void stepperTask(void *);
 
   public:
@@ -370,6 +375,11 @@ class Stepper {
       static constexpr uint8_t oversampling_factor = 0;
     #endif
 
+    #if ENABLED(STEP_COMPILER)
+      static const step_table_t *step_table; // Pre-compiled step events for the current block, if any
+      static uint16_t step_table_event;      // Index of the next event in the step table
+    #endif
+
     // Delta error variables for the Bresenham line tracer
     static xyze_long_t delta_error;
     static xyze_long_t advance_dividend;
@@ -486,6 +496,11 @@ class Stepper {
       }
     #endif
 
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      // Get the oversampling factor for a block with the given nominal rate
+      static uint8_t calc_oversampling(uint32_t max_rate);
+    #endif
+
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t * const block);
 
@@ -520,6 +535,7 @@ class Stepper {
         if (current_block->is_page()) page_manager.free_page(current_block->page_idx);
       #endif
       current_block = nullptr;
+      TERN_(STEP_COMPILER, step_table = nullptr);
       axis_did_move = 0;
       planner.release_current_block();
       TERN_(LIN_ADVANCE, la_interval = nextAdvanceISR = LA_ADV_NEVER);
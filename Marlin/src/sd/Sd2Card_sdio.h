@@ -29,6 +29,12 @@
 bool SDIO_Init();
 bool SDIO_ReadBlock(uint32_t block, uint8_t *dst);
 bool SDIO_WriteBlock(uint32_t block, const uint8_t *src);
+#ifdef HAL_SDIO_READ_BLOCKS
+  bool SDIO_ReadBlocks(uint32_t block, uint8_t *dst, const uint8_t count);
+#endif
+#ifdef HAL_SDIO_WRITE_BLOCKS
+  bool SDIO_WriteBlocks(uint32_t block, const uint8_t *src, const uint8_t count);
+#endif
 bool SDIO_IsReady();
 uint32_t SDIO_GetCardSize();
 
@@ -48,6 +54,12 @@ class DiskIODriver_SDIO : public DiskIODriver {
 
     bool readBlock(uint32_t block, uint8_t *dst)          override { return SDIO_ReadBlock(block, dst); }
     bool writeBlock(uint32_t block, const uint8_t *src)   override { return SDIO_WriteBlock(block, src); }
+    #ifdef HAL_SDIO_READ_BLOCKS
+      bool readBlocks(uint32_t block, uint8_t *dst, const uint8_t count) override { return SDIO_ReadBlocks(block, dst, count); }
+    #endif
+    #ifdef HAL_SDIO_WRITE_BLOCKS
+      bool writeBlocks(uint32_t block, const uint8_t *src, const uint8_t count) override { return SDIO_WriteBlocks(block, src, count); }
+    #endif
 
     uint32_t cardSize()                                   override { return SDIO_GetCardSize(); }
 
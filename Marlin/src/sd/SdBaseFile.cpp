@@ -77,11 +77,12 @@ bool SdBaseFile::addDirCluster() {
   vol_->cacheSetBlockNumber(block, true);
 
   // zero first block of cluster
-  memset(vol_->cacheBuffer_.data, 0, 512);
+  memset(vol_->cache()->data, 0, 512);
 
   // zero rest of cluster
   for (uint8_t i = 1; i < vol_->blocksPerCluster_; i++) {
-    if (!vol_->writeBlock(block + i, vol_->cacheBuffer_.data)) return false;
+    vol_->cacheInvalidate(block + i);
+    if (!vol_->writeBlock(block + i, vol_->cache()->data)) return false;
   }
   // Increase directory file size by cluster size
   fileSize_ += 512UL << vol_->clusterSizeShift_;
@@ -106,6 +107,7 @@ dir_t* SdBaseFile::cacheDirEntry(const uint8_t action) {
 bool SdBaseFile::close() {
   bool rtn = sync();
   type_ = FAT_FILE_TYPE_CLOSED;
+  TERN_(SDCARD_FILE_EXTENTS, extentCount_ = 0);
   return rtn;
 }
 
@@ -941,6 +943,7 @@ bool SdBaseFile::openCachedEntry(const uint8_t dirIndex, const uint8_t oflag) {
   // set to start of file
   curCluster_ = 0;
   curPosition_ = 0;
+  TERN_(SDCARD_FILE_EXTENTS, extentCount_ = 0);
   if ((oflag & O_TRUNC) && !truncate(0)) return false;
   return oflag & O_AT_END ? seekEnd(0) : true;
 
@@ -1208,7 +1211,7 @@ bool SdBaseFile::openParent(SdBaseFile *dir) {
   // first block of parent dir
   if (!vol_->cacheRawBlock(lbn, SdVolume::CACHE_FOR_READ)) return false;
 
-  dir_t *p = &vol_->cacheBuffer_.dir[1];
+  dir_t *p = &vol_->cache()->dir[1];
   // verify name for '../..'
   if (p->name[0] != '.' || p->name[1] != '.') return false;
   // '..' is pointer to first cluster of parent. open '../..' to find parent
@@ -1390,7 +1393,7 @@ int16_t SdBaseFile::read(void * const buf, uint16_t nbyte) {
         // start of new cluster
         if (curPosition_ == 0)
           curCluster_ = firstCluster_;                      // use first cluster in file
-        else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
+        else if (!nextCluster())                            // get next cluster
           return -1;
       }
       block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
@@ -1401,12 +1404,12 @@ int16_t SdBaseFile::read(void * const buf, uint16_t nbyte) {
     NOMORE(n, 512 - offset);
 
     // no buffering needed if n == 512
-    if (n == 512 && block != vol_->cacheBlockNumber()) {
+    if (n == 512 && !vol_->isCached(block)) {
       if (!vol_->readBlock(block, dst)) return -1;
     }
     else {
       // read block to cache and copy data to caller
-      if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) return -1;
+      if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ, isFile())) return -1;
       uint8_t *src = vol_->cache()->data + offset;
       memcpy(dst, src, n);
     }
@@ -1417,6 +1420,108 @@ int16_t SdBaseFile::read(void * const buf, uint16_t nbyte) {
   return nbyte;
 }
 
+/**
+ * Read whole blocks from a file starting at the current position.
+ * Blocks within one cluster are read in a single multiple block transfer.
+ *
+ * \param[out] dst Pointer to the location that will receive the data.
+ *
+ * \param[in] maxBlocks Maximum number of blocks to read.
+ *
+ * \return The number of blocks read, zero at end of file, or -1 on error.
+ * The current position must be on a block boundary. Data past the end of
+ * the file in the last block is undefined.
+ */
+int16_t SdBaseFile::readBlocks(uint8_t * const dst, const uint8_t maxBlocks) {
+  // error if not an open file or miss-positioned
+  if (!isFile() || !(flags_ & O_READ) || (curPosition_ & 0x1FF)) return -1;
+
+  if (curPosition_ >= fileSize_) return 0;
+
+  const uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+  if (blockOfCluster == 0) {
+    // start of new cluster
+    if (curPosition_ == 0)
+      curCluster_ = firstCluster_;
+    else if (!nextCluster())
+      return -1;
+  }
+  const uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+
+  // stay within the cluster and the file
+  uint8_t n = _MIN(maxBlocks, vol_->blocksPerCluster() - blockOfCluster);
+  NOMORE(n, (fileSize_ - curPosition_ + 511) >> 9);
+
+  // write back cached blocks the transfer would pass over
+  if (!vol_->cacheFlush(block, n)) return -1;
+
+  if (!vol_->readBlocks(block, dst, n)) return -1;
+
+  curPosition_ = _MIN(curPosition_ + (uint32_t(n) << 9), fileSize_);
+  return n;
+}
+
+// Move to the next cluster of the file, at the start of a cluster
+bool SdBaseFile::nextCluster() {
+  #if ENABLED(SDCARD_FILE_EXTENTS)
+    if (extentCluster(curPosition_ >> (vol_->clusterSizeShift_ + 9), &curCluster_)) return true;
+  #endif
+  return vol_->fatGet(curCluster_, &curCluster_);
+}
+
+#if ENABLED(SDCARD_FILE_EXTENTS)
+
+  /**
+   * Map the cluster chain of a file opened for read as runs of contiguous
+   * clusters, so reads and seeks can find clusters without the FAT.
+   * If the chain has more runs than fit in the table, only the first part
+   * of the file is mapped and the FAT is followed for the rest.
+   *
+   * \param[out] table Room for \a size runs and an end marker.
+   *
+   * \param[in] size Maximum number of runs.
+   *
+   * \return true for success, false for failure.
+   */
+  bool SdBaseFile::resolveExtents(file_extent_t * const table, const uint8_t size) {
+    extentCount_ = 0;
+    if (!isFile() || (flags_ & O_WRITE) || !firstCluster_ || !size) return false;
+
+    const uint8_t shift = vol_->clusterSizeShift_ + 9;
+    uint32_t clusters = (fileSize_ + (1UL << shift) - 1) >> shift,
+             cluster = firstCluster_;
+    uint8_t count = 0;
+    table[0].index = 0;
+    table[0].cluster = cluster;
+    for (uint32_t n = 1; n < clusters; ++n) {
+      uint32_t next;
+      if (!vol_->fatGet(cluster, &next) || vol_->isEOC(next)) return false;
+      if (next != cluster + 1) {
+        // a new run, if there's room for it
+        if (++count == size) { clusters = n; break; }
+        table[count].index = n;
+        table[count].cluster = next;
+      }
+      cluster = next;
+    }
+    if (count < size) count++;
+    table[count].index = clusters;    // end marker
+    extents_ = table;
+    extentCount_ = count;
+    return true;
+  }
+
+  // Get a cluster of the file by index, if it's mapped
+  bool SdBaseFile::extentCluster(const uint32_t index, uint32_t * const cluster) const {
+    if (!extentCount_ || index >= extents_[extentCount_].index) return false;
+    uint8_t i = extentCount_ - 1;
+    while (extents_[i].index > index) i--;
+    *cluster = extents_[i].cluster + (index - extents_[i].index);
+    return true;
+  }
+
+#endif // SDCARD_FILE_EXTENTS
+
 /**
  * Read the next entry in a directory.
  *
@@ -1932,6 +2037,13 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
   nCur = (curPosition_ - 1) >> (vol_->clusterSizeShift_ + 9);
   nNew = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
 
+  #if ENABLED(SDCARD_FILE_EXTENTS)
+    if (extentCluster(nNew, &curCluster_)) {
+      curPosition_ = pos;
+      return true;
+    }
+  #endif
+
   if (nNew < nCur || curPosition_ == 0)
     curCluster_ = firstCluster_;      // must follow chain from first cluster
   else
@@ -2195,26 +2307,7 @@ int16_t SdBaseFile::write(const void *buf, const uint16_t nbyte) {
     uint16_t blockOffset = curPosition_ & 0x1FF;
     if (blockOfCluster == 0 && blockOffset == 0) {
       // start of new cluster
-      if (curCluster_ == 0) {
-        if (firstCluster_ == 0) {
-          // allocate first cluster of file
-          if (!addCluster()) goto FAIL;
-        }
-        else {
-          curCluster_ = firstCluster_;
-        }
-      }
-      else {
-        uint32_t next;
-        if (!vol_->fatGet(curCluster_, &next)) goto FAIL;
-        if (vol_->isEOC(next)) {
-          // add cluster if at end of chain
-          if (!addCluster()) goto FAIL;
-        }
-        else {
-          curCluster_ = next;
-        }
-      }
+      if (!nextWriteCluster()) goto FAIL;
     }
     // max space in block
     uint16_t n = 512 - blockOffset;
@@ -2226,10 +2319,8 @@ int16_t SdBaseFile::write(const void *buf, const uint16_t nbyte) {
     uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
     if (n == 512) {
       // full block - don't need to use cache
-      if (vol_->cacheBlockNumber() == block) {
-        // invalidate cache if block is in cache
-        vol_->cacheSetBlockNumber(0xFFFFFFFF, false);
-      }
+      // invalidate cache if block is in cache
+      vol_->cacheInvalidate(block);
       if (!vol_->writeBlock(block, src)) goto FAIL;
     }
     else {
@@ -2237,11 +2328,11 @@ int16_t SdBaseFile::write(const void *buf, const uint16_t nbyte) {
         // start of new block don't need to read into cache
         if (!vol_->cacheFlush()) goto FAIL;
         // set cache dirty and SD address of block
-        vol_->cacheSetBlockNumber(block, true);
+        vol_->cacheSetBlockNumber(block, true, isFile());
       }
       else {
         // rewrite part of block
-        if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE)) goto FAIL;
+        if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_WRITE, isFile())) goto FAIL;
       }
       uint8_t *dst = vol_->cache()->data + blockOffset;
       memcpy(dst, src, n);
@@ -2271,4 +2362,81 @@ int16_t SdBaseFile::write(const void *buf, const uint16_t nbyte) {
   return -1;
 }
 
+/**
+ * Write whole blocks to a file at the current position.
+ * Blocks within one cluster are pre-erased and written in a single
+ * multiple block transfer.
+ *
+ * \param[in] src Pointer to the location of the data to be written.
+ *
+ * \param[in] maxBlocks Maximum number of blocks to write.
+ *
+ * \return The number of blocks written, or -1 on error.
+ * The current position must be on a block boundary.
+ */
+int16_t SdBaseFile::writeBlocks(const uint8_t *src, const uint8_t maxBlocks) {
+  #if ENABLED(SDCARD_READONLY)
+    writeError = true; return -1;
+  #endif
+
+  // error if not a normal file or is read-only
+  if (!isFile() || !(flags_ & O_WRITE)) goto FAIL;
+
+  // seek to end of file if append flag
+  if ((flags_ & O_APPEND) && curPosition_ != fileSize_) {
+    if (!seekEnd()) goto FAIL;
+  }
+
+  // error if miss-positioned
+  if (curPosition_ & 0x1FF) goto FAIL;
+
+  {
+    const uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+    if (blockOfCluster == 0) {
+      // start of new cluster
+      if (!nextWriteCluster()) goto FAIL;
+    }
+    const uint32_t block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+
+    // stay within the cluster
+    const uint8_t n = _MIN(maxBlocks, vol_->blocksPerCluster() - blockOfCluster);
+
+    // invalidate cached copies of the blocks being replaced
+    for (uint8_t i = 0; i < n; ++i) vol_->cacheInvalidate(block + i);
+
+    if (!vol_->writeBlocks(block, src, n)) goto FAIL;
+
+    curPosition_ += uint32_t(n) << 9;
+    if (curPosition_ > fileSize_) fileSize_ = curPosition_;
+    // insure sync will update dir entry
+    flags_ |= F_FILE_DIR_DIRTY;
+
+    if (flags_ & O_SYNC) {
+      if (!sync()) goto FAIL;
+    }
+    return n;
+  }
+
+  FAIL:
+  writeError = true;
+  return -1;
+}
+
+// Move to the cluster for a write at the start of a cluster,
+// adding one at the end of the chain
+bool SdBaseFile::nextWriteCluster() {
+  if (curCluster_ == 0) {
+    // allocate first cluster of file
+    if (firstCluster_ == 0) return addCluster();
+    curCluster_ = firstCluster_;
+    return true;
+  }
+  uint32_t next;
+  if (!vol_->fatGet(curCluster_, &next)) return false;
+  // add cluster if at end of chain
+  if (vol_->isEOC(next)) return addCluster();
+  curCluster_ = next;
+  return true;
+}
+
 #endif // HAS_MEDIA
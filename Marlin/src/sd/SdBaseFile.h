@@ -46,6 +46,15 @@ struct filepos_t {
   filepos_t() : position(0), cluster(0) {}
 };
 
+/**
+ * \struct file_extent_t
+ * \brief A run of contiguous clusters in a file
+ */
+struct file_extent_t {
+  uint32_t index;     // index in the file of the first cluster in the run
+  uint32_t cluster;   // first cluster of the run
+};
+
 // use the gnu style oflag in open()
 uint8_t const O_READ = 0x01,                    // open() oflag for reading
               O_RDONLY = O_READ,                // open() oflag - same as O_IN
@@ -162,7 +171,7 @@ uint16_t const FAT_DEFAULT_TIME = (1 << 11);
  */
 class SdBaseFile {
  public:
-  SdBaseFile() : writeError(false), type_(FAT_FILE_TYPE_CLOSED) {}
+  SdBaseFile() : writeError(false), type_(FAT_FILE_TYPE_CLOSED) { TERN_(SDCARD_FILE_EXTENTS, extentCount_ = 0); }
   SdBaseFile(const char * const path, const uint8_t oflag);
   ~SdBaseFile() { if (isOpen()) close(); }
 
@@ -297,6 +306,10 @@ class SdBaseFile {
   bool printName();
   int16_t read();
   int16_t read(void * const buf, uint16_t nbyte);
+  int16_t readBlocks(uint8_t * const dst, const uint8_t maxBlocks);
+  #if ENABLED(SDCARD_FILE_EXTENTS)
+    bool resolveExtents(file_extent_t * const table, const uint8_t size);
+  #endif
   int8_t readDir(dir_t * const dir, char * const longFilename);
   static bool remove(SdBaseFile * const dirFile, const char * const path);
   bool remove();
@@ -346,6 +359,7 @@ class SdBaseFile {
    */
   SdVolume* volume() const { return vol_; }
   int16_t write(const void *buf, const uint16_t nbyte);
+  int16_t writeBlocks(const uint8_t *src, const uint8_t maxBlocks);
 
  private:
   friend class SdFat;           // allow SdFat to set cwd_
@@ -370,12 +384,20 @@ class SdBaseFile {
   uint32_t  firstCluster_;  // first cluster of file
   SdVolume  *vol_;          // volume where file is located
 
+  #if ENABLED(SDCARD_FILE_EXTENTS)
+    file_extent_t *extents_;  // runs of the cluster chain, set by resolveExtents()
+    uint8_t   extentCount_;   // number of runs, or 0 to follow the FAT
+    bool extentCluster(const uint32_t index, uint32_t * const cluster) const;
+  #endif
+
   /**
    * EXPERIMENTAL - Don't use!
    */
   //bool openParent(SdBaseFile *dir);
 
   // private functions
+  bool nextCluster();
+  bool nextWriteCluster();
   bool addCluster();
   bool addDirCluster();
   dir_t* cacheDirEntry(const uint8_t action);
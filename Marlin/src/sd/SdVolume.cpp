@@ -39,11 +39,13 @@
 
 #if !USE_MULTIPLE_CARDS
   // raw block cache
-  uint32_t SdVolume::cacheBlockNumber_;  // current block number
-  cache_t  SdVolume::cacheBuffer_;       // 512 byte cache for Sd2Card
+  cache_entry_t SdVolume::cache_[SD_CACHE_BLOCKS]; // cached blocks
+  uint8_t  SdVolume::cacheCurrent_;      // entry for the current block
+  uint32_t SdVolume::cacheUses_;         // access count for LRU
   DiskIODriver *SdVolume::sdCard_;       // pointer to SD card object
-  bool     SdVolume::cacheDirty_;        // cacheFlush() will write block if true
-  uint32_t SdVolume::cacheMirrorBlock_;  // mirror  block for second FAT
+  #if ENABLED(SDCARD_BLOCK_CACHE)
+    cache_stats_t SdVolume::cacheStats_;
+  #endif
 #endif
 
 // find a contiguous group of clusters
@@ -120,34 +122,92 @@ bool SdVolume::allocContiguous(const uint32_t count, uint32_t * const curCluster
   return true;
 }
 
-bool SdVolume::cacheFlush() {
+// write a cached block back to the card if it's dirty
+bool SdVolume::cacheWriteBack(cache_entry_t &entry) {
   #if DISABLED(SDCARD_READONLY)
-    if (cacheDirty_) {
-      if (!sdCard_->writeBlock(cacheBlockNumber_, cacheBuffer_.data))
+    if (entry.dirty) {
+      if (!sdCard_->writeBlock(entry.blockNumber, entry.buffer.data))
         return false;
 
       // mirror FAT tables
-      if (cacheMirrorBlock_) {
-        if (!sdCard_->writeBlock(cacheMirrorBlock_, cacheBuffer_.data))
+      if (entry.mirrorBlock) {
+        if (!sdCard_->writeBlock(entry.mirrorBlock, entry.buffer.data))
           return false;
-        cacheMirrorBlock_ = 0;
+        entry.mirrorBlock = 0;
       }
-      cacheDirty_ = 0;
+      entry.dirty = false;
+      TERN_(SDCARD_BLOCK_CACHE, cacheStats_.writes++);
     }
   #endif
   return true;
 }
 
-bool SdVolume::cacheRawBlock(const uint32_t blockNumber, const bool dirty) {
-  if (cacheBlockNumber_ != blockNumber) {
-    if (!cacheFlush()) return false;
-    if (!sdCard_->readBlock(blockNumber, cacheBuffer_.data)) return false;
-    cacheBlockNumber_ = blockNumber;
+// write all dirty blocks back to the card
+bool SdVolume::cacheFlush() {
+  for (uint8_t i = 0; i < SD_CACHE_BLOCKS; ++i)
+    if (!cacheWriteBack(cache_[i])) return false;
+  return true;
+}
+
+// write back dirty blocks in a range, before reading it around the cache
+bool SdVolume::cacheFlush(const uint32_t blockNumber, const uint8_t count) {
+  for (uint8_t i = 0; i < SD_CACHE_BLOCKS; ++i)
+    if (cache_[i].blockNumber - blockNumber < count && !cacheWriteBack(cache_[i])) return false;
+  return true;
+}
+
+// find the entry holding a block, or -1
+int8_t SdVolume::cacheFind(const uint32_t blockNumber) {
+  for (uint8_t i = 0; i < SD_CACHE_BLOCKS; ++i)
+    if (cache_[i].blockNumber == blockNumber) return i;
+  return -1;
+}
+
+// least recently used entry in the FAT / directory or the data part of the cache
+uint8_t SdVolume::cacheVictim(const bool data) {
+  const uint8_t first = (data && SD_CACHE_DATA_BLOCKS) ? SD_CACHE_FAT_BLOCKS : 0,
+                end = (data && SD_CACHE_DATA_BLOCKS) ? SD_CACHE_BLOCKS : SD_CACHE_FAT_BLOCKS;
+  uint8_t victim = first;
+  for (uint8_t i = first + 1; i < end; ++i)
+    if (int32_t(cache_[i].lastUse - cache_[victim].lastUse) < 0) victim = i;
+  return victim;
+}
+
+bool SdVolume::cacheRawBlock(const uint32_t blockNumber, const bool dirty, const bool data/*=false*/) {
+  bool miss = false;
+  if (cache_[cacheCurrent_].blockNumber != blockNumber) {
+    int8_t i = cacheFind(blockNumber);
+    if (i < 0) {
+      i = cacheVictim(data);
+      cache_entry_t &entry = cache_[i];
+      if (!cacheWriteBack(entry)) return false;
+      entry.blockNumber = 0xFFFFFFFF;
+      if (!sdCard_->readBlock(blockNumber, entry.buffer.data)) return false;
+      entry.blockNumber = blockNumber;
+      miss = true;
+    }
+    cacheCurrent_ = i;
   }
-  if (dirty) cacheDirty_ = true;
+  TERN_(SDCARD_BLOCK_CACHE, (miss ? cacheStats_.misses : cacheStats_.hits)[data]++);
+  UNUSED(miss);
+
+  cache_entry_t &entry = cache_[cacheCurrent_];
+  entry.lastUse = ++cacheUses_;
+  if (dirty) entry.dirty = true;
   return true;
 }
 
+// used by SdBaseFile write to assign a cache entry to an SD location
+// without reading it. Call cacheFlush() first.
+void SdVolume::cacheSetBlockNumber(const uint32_t blockNumber, const bool dirty, const bool data/*=false*/) {
+  const int8_t i = cacheFind(blockNumber);
+  cacheCurrent_ = i >= 0 ? i : cacheVictim(data);
+  cache_entry_t &entry = cache_[cacheCurrent_];
+  entry.blockNumber = blockNumber;
+  entry.lastUse = ++cacheUses_;
+  entry.dirty = dirty;
+}
+
 // return the size in bytes of a cluster chain
 bool SdVolume::chainSize(uint32_t cluster, uint32_t * const size) {
   uint32_t s = 0;
@@ -169,13 +229,13 @@ bool SdVolume::fatGet(const uint32_t cluster, uint32_t * const value) {
     lba = fatStartBlock_ + (index >> 9);
     if (!cacheRawBlock(lba, CACHE_FOR_READ)) return false;
     index &= 0x1FF;
-    uint16_t tmp = cacheBuffer_.data[index];
+    uint16_t tmp = cache()->data[index];
     index++;
     if (index == 512) {
       if (!cacheRawBlock(lba + 1, CACHE_FOR_READ)) return false;
       index = 0;
     }
-    tmp |= cacheBuffer_.data[index] << 8;
+    tmp |= cache()->data[index] << 8;
     *value = cluster & 1 ? tmp >> 4 : tmp & 0xFFF;
     return true;
   }
@@ -187,10 +247,9 @@ bool SdVolume::fatGet(const uint32_t cluster, uint32_t * const value) {
   else
     return false;
 
-  if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
-    return false;
+  if (!cacheRawBlock(lba, CACHE_FOR_READ)) return false;
 
-  *value = (fatType_ == 16) ? cacheBuffer_.fat16[cluster & 0xFF] : (cacheBuffer_.fat32[cluster & 0x7F] & FAT32MASK);
+  *value = (fatType_ == 16) ? cache()->fat16[cluster & 0xFF] : (cache()->fat32[cluster & 0x7F] & FAT32MASK);
   return true;
 }
 
@@ -211,26 +270,26 @@ bool SdVolume::fatPut(const uint32_t cluster, const uint32_t value) {
     lba = fatStartBlock_ + (index >> 9);
     if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
     // mirror second FAT
-    if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+    if (fatCount_ > 1) cacheEntry().mirrorBlock = lba + blocksPerFat_;
     index &= 0x1FF;
     uint8_t tmp = value;
     if (cluster & 1) {
-      tmp = (cacheBuffer_.data[index] & 0xF) | tmp << 4;
+      tmp = (cache()->data[index] & 0xF) | tmp << 4;
     }
-    cacheBuffer_.data[index] = tmp;
+    cache()->data[index] = tmp;
     index++;
     if (index == 512) {
       lba++;
       index = 0;
       if (!cacheRawBlock(lba, CACHE_FOR_WRITE)) return false;
       // mirror second FAT
-      if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+      if (fatCount_ > 1) cacheEntry().mirrorBlock = lba + blocksPerFat_;
     }
     tmp = value >> 4;
     if (!(cluster & 1)) {
-      tmp = ((cacheBuffer_.data[index] & 0xF0)) | tmp >> 4;
+      tmp = ((cache()->data[index] & 0xF0)) | tmp >> 4;
     }
-    cacheBuffer_.data[index] = tmp;
+    cache()->data[index] = tmp;
     return true;
   }
 
@@ -245,12 +304,12 @@ bool SdVolume::fatPut(const uint32_t cluster, const uint32_t value) {
 
   // store entry
   if (fatType_ == 16)
-    cacheBuffer_.fat16[cluster & 0xFF] = value;
+    cache()->fat16[cluster & 0xFF] = value;
   else
-    cacheBuffer_.fat32[cluster & 0x7F] = value;
+    cache()->fat32[cluster & 0x7F] = value;
 
   // mirror second FAT
-  if (fatCount_ > 1) cacheMirrorBlock_ = lba + blocksPerFat_;
+  if (fatCount_ > 1) cacheEntry().mirrorBlock = lba + blocksPerFat_;
   return true;
 }
 
@@ -293,11 +352,11 @@ int32_t SdVolume::freeClusterCount() {
     NOMORE(n, todo);
     if (fatType_ == 16) {
       for (uint16_t i = 0; i < n; i++)
-        if (cacheBuffer_.fat16[i] == 0) free++;
+        if (cache()->fat16[i] == 0) free++;
     }
     else {
       for (uint16_t i = 0; i < n; i++)
-        if (cacheBuffer_.fat32[i] == 0) free++;
+        if (cache()->fat32[i] == 0) free++;
     }
     #ifdef ESP32
       // Needed to reset the idle task watchdog timer on ESP32 as reading the complete FAT may easily
@@ -333,22 +392,25 @@ bool SdVolume::init(DiskIODriver * const dev, const uint8_t part) {
   sdCard_ = dev;
   fatType_ = 0;
   allocSearchStart_ = 2;
-  cacheDirty_ = 0;  // cacheFlush() will write block if true
-  cacheMirrorBlock_ = 0;
-  cacheBlockNumber_ = 0xFFFFFFFF;
+  for (uint8_t i = 0; i < SD_CACHE_BLOCKS; ++i) {
+    cache_[i].blockNumber = 0xFFFFFFFF;
+    cache_[i].mirrorBlock = 0;
+    cache_[i].dirty = false;  // cacheFlush() will write block if true
+  }
+  cacheCurrent_ = 0;
 
   // if part == 0 assume super floppy with FAT boot sector in block zero
   // if part > 0 assume mbr volume with partition table
   if (part) {
     if (part > 4) return false;
     if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ)) return false;
-    part_t *p = &cacheBuffer_.mbr.part[part - 1];
+    part_t *p = &cache()->mbr.part[part - 1];
     if ((p->boot & 0x7F) != 0  || p->totalSectors < 100 || p->firstSector == 0)
       return false; // not a valid partition
     volumeStartBlock = p->firstSector;
   }
   if (!cacheRawBlock(volumeStartBlock, CACHE_FOR_READ)) return false;
-  fbs = &cacheBuffer_.fbs32;
+  fbs = &cache()->fbs32;
   if (fbs->bytesPerSector != 512 ||
       fbs->fatCount == 0 ||
       fbs->reservedSectorCount == 0 ||
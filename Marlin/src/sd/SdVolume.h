@@ -64,6 +64,38 @@ union cache_t {
   fat32_fsinfo_t  fsinfo;     // Used to access to a cached FAT32 FSINFO sector.
 };
 
+/**
+ * The block cache has a part for FAT and directory blocks and a part for
+ * file data, so reading a file doesn't evict the FAT block for its chain.
+ */
+#if ENABLED(SDCARD_BLOCK_CACHE)
+  #define SD_CACHE_FAT_BLOCKS  SDCARD_CACHE_FAT_BLOCKS
+  #define SD_CACHE_DATA_BLOCKS SDCARD_CACHE_DATA_BLOCKS
+#else
+  #define SD_CACHE_FAT_BLOCKS  1
+  #define SD_CACHE_DATA_BLOCKS 0  // File data shares the one cache block
+#endif
+#define SD_CACHE_BLOCKS (SD_CACHE_FAT_BLOCKS + SD_CACHE_DATA_BLOCKS)
+
+/**
+ * \brief A cached block and its state
+ */
+struct cache_entry_t {
+  cache_t  buffer;       // 512 byte cache for a device block
+  uint32_t blockNumber;  // Logical number of the cached block
+  uint32_t mirrorBlock;  // block number for mirror FAT
+  uint32_t lastUse;      // Access count at the last use, for LRU
+  bool     dirty;        // cacheFlush() will write block if true
+};
+
+/**
+ * \brief Block cache hit and miss counts, for M963
+ */
+struct cache_stats_t {
+  uint32_t hits[2], misses[2];  // [0] FAT and directory, [1] file data
+  uint32_t writes;              // Dirty blocks written back
+};
+
 /**
  * \class SdVolume
  * \brief Access FAT16 and FAT32 volumes on SD and SDHC cards.
@@ -79,8 +111,8 @@ class SdVolume {
    */
   cache_t* cacheClear() {
     if (!cacheFlush()) return 0;
-    cacheBlockNumber_ = 0xFFFFFFFF;
-    return &cacheBuffer_;
+    cacheEntry().blockNumber = 0xFFFFFFFF;
+    return cache();
   }
 
   /**
@@ -129,6 +161,10 @@ class SdVolume {
    */
   bool dbgFat(const uint32_t n, uint32_t * const v) { return fatGet(n, v); }
 
+  #if ENABLED(SDCARD_BLOCK_CACHE)
+    cache_stats_t& cacheStats() { return cacheStats_; }
+  #endif
+
  private:
   // Allow SdBaseFile access to SdVolume private data.
   friend class SdBaseFile;
@@ -139,17 +175,21 @@ class SdVolume {
   static bool const CACHE_FOR_WRITE = true;
 
   #if USE_MULTIPLE_CARDS
-    cache_t cacheBuffer_;        // 512 byte cache for device blocks
-    uint32_t cacheBlockNumber_;  // Logical number of block in the cache
+    cache_entry_t cache_[SD_CACHE_BLOCKS]; // Cached device blocks
+    uint8_t cacheCurrent_;       // Entry for the block most recently cached
+    uint32_t cacheUses_;         // Count of cache accesses, for LRU
     DiskIODriver *sdCard_;       // DiskIODriver object for cache
-    bool cacheDirty_;            // cacheFlush() will write block if true
-    uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    #if ENABLED(SDCARD_BLOCK_CACHE)
+      cache_stats_t cacheStats_;
+    #endif
   #else
-    static cache_t cacheBuffer_;        // 512 byte cache for device blocks
-    static uint32_t cacheBlockNumber_;  // Logical number of block in the cache
+    static cache_entry_t cache_[SD_CACHE_BLOCKS]; // Cached device blocks
+    static uint8_t cacheCurrent_;       // Entry for the block most recently cached
+    static uint32_t cacheUses_;         // Count of cache accesses, for LRU
     static DiskIODriver *sdCard_;       // DiskIODriver object for cache
-    static bool cacheDirty_;            // cacheFlush() will write block if true
-    static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    #if ENABLED(SDCARD_BLOCK_CACHE)
+      static cache_stats_t cacheStats_;
+    #endif
   #endif
 
   uint32_t allocSearchStart_;   // start cluster for alloc search
@@ -169,23 +209,40 @@ class SdVolume {
   uint32_t clusterStartBlock(const uint32_t cluster) const { return dataStartBlock_ + ((cluster - 2) << clusterSizeShift_); }
   uint32_t blockNumber(const uint32_t cluster, const uint32_t position) const { return clusterStartBlock(cluster) + blockOfCluster(position); }
 
-  cache_t* cache() { return &cacheBuffer_; }
-  uint32_t cacheBlockNumber() const { return cacheBlockNumber_; }
+  // The block most recently cached
+  cache_entry_t& cacheEntry() { return cache_[cacheCurrent_]; }
+  cache_t* cache() { return &cacheEntry().buffer; }
+  uint32_t cacheBlockNumber() const { return cache_[cacheCurrent_].blockNumber; }
 
   #if USE_MULTIPLE_CARDS
     bool cacheFlush();
-    bool cacheRawBlock(const uint32_t blockNumber, const bool dirty);
+    bool cacheFlush(const uint32_t blockNumber, const uint8_t count);
+    bool cacheRawBlock(const uint32_t blockNumber, const bool dirty, const bool data=false);
+    void cacheSetBlockNumber(const uint32_t blockNumber, const bool dirty, const bool data=false);
+    int8_t cacheFind(const uint32_t blockNumber);
+    uint8_t cacheVictim(const bool data);
+    bool cacheWriteBack(cache_entry_t &entry);
   #else
     static bool cacheFlush();
-    static bool cacheRawBlock(const uint32_t blockNumber, const bool dirty);
+    static bool cacheFlush(const uint32_t blockNumber, const uint8_t count);
+    static bool cacheRawBlock(const uint32_t blockNumber, const bool dirty, const bool data=false);
+    static void cacheSetBlockNumber(const uint32_t blockNumber, const bool dirty, const bool data=false);
+    static int8_t cacheFind(const uint32_t blockNumber);
+    static uint8_t cacheVictim(const bool data);
+    static bool cacheWriteBack(cache_entry_t &entry);
   #endif
 
-  // used by SdBaseFile write to assign cache to SD location
-  void cacheSetBlockNumber(uint32_t blockNumber, bool dirty) {
-    cacheDirty_ = dirty;
-    cacheBlockNumber_  = blockNumber;
+  bool isCached(const uint32_t blockNumber) { return cacheFind(blockNumber) >= 0; }
+
+  // Drop a block from the cache, used when SdBaseFile write replaces it on the card
+  void cacheInvalidate(const uint32_t blockNumber) {
+    const int8_t i = cacheFind(blockNumber);
+    if (i >= 0) {
+      cache_[i].blockNumber = 0xFFFFFFFF;
+      cache_[i].dirty = false;
+    }
   }
-  void cacheSetDirty() { cacheDirty_ |= CACHE_FOR_WRITE; }
+  void cacheSetDirty() { cacheEntry().dirty |= CACHE_FOR_WRITE; }
   bool chainSize(uint32_t cluster, uint32_t * const size);
   bool fatGet(const uint32_t cluster, uint32_t * const value);
   bool fatPut(const uint32_t cluster, const uint32_t value);
@@ -197,7 +254,9 @@ class SdVolume {
     return cluster >= FAT32EOC_MIN;
   }
   bool readBlock(const uint32_t block, uint8_t * const dst) { return sdCard_->readBlock(block, dst); }
+  bool readBlocks(const uint32_t block, uint8_t * const dst, const uint8_t count) { return sdCard_->readBlocks(block, dst, count); }
   bool writeBlock(const uint32_t block, const uint8_t * const dst) { return sdCard_->writeBlock(block, dst); }
+  bool writeBlocks(const uint32_t block, const uint8_t * const src, const uint8_t count) { return sdCard_->writeBlocks(block, src, count); }
 };
 
 using MarlinVolume = SdVolume;
@@ -60,6 +60,10 @@
   #include "../../src/lcd/menu/menu.h"
 #endif
 
+#if ENABLED(SDCARD_COMPRESSED_GCODE)
+  #include "../libs/heatshrink/heatshrink_decoder.h"
+#endif
+
 #define DEBUG_OUT ANY(DEBUG_CARDREADER, MARLIN_DEV_MODE)
 #include "../core/debug_out.h"
 #include "../libs/hex_print.h"
@@ -87,6 +91,10 @@ MediaFile CardReader::root, CardReader::workDir, CardReader::workDirParents[MAX_
 uint8_t CardReader::workDirDepth;
 int16_t CardReader::nrItems = -1;
 
+#if ENABLED(SDCARD_DIR_INDEX)
+  uint16_t CardReader::dir_index[SDCARD_DIR_INDEX_MAX];
+#endif
+
 #if ENABLED(SDCARD_SORT_ALPHA)
 
   int16_t CardReader::sort_count;
@@ -148,6 +156,34 @@ MediaFile CardReader::file;
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(SDCARD_READ_AHEAD)
+  uint8_t CardReader::ra_buffer[SDCARD_READ_AHEAD_BLOCKS][512] __attribute__((aligned(4)));
+  uint8_t CardReader::ra_head, CardReader::ra_count;
+  uint32_t CardReader::ra_offset;
+  uint16_t CardReader::ra_skip;
+  uint8_t *CardReader::ra_pos, *CardReader::ra_end;
+#endif
+
+#if ENABLED(SDCARD_WRITE_BEHIND)
+  uint8_t CardReader::wb_buffer[SDCARD_WRITE_BEHIND_BLOCKS][512] __attribute__((aligned(4)));
+  uint8_t CardReader::wb_head, CardReader::wb_count;
+  uint16_t CardReader::wb_fill;
+#endif
+
+#if ENABLED(SDCARD_FILE_EXTENTS)
+  static file_extent_t file_extents[SDCARD_FILE_EXTENTS_MAX + 1]; // Cluster runs of the open file
+#endif
+
+#if ENABLED(SDCARD_COMPRESSED_GCODE)
+  bool CardReader::hs_eof;
+  static heatshrink_decoder hsd;
+  #if DISABLED(SDCARD_READ_AHEAD)
+    static uint8_t hs_in[32], hs_in_index, hs_in_count; // Compressed bytes read from the file
+  #endif
+  static uint8_t hs_out[32], hs_out_index, hs_out_count; // Decompressed bytes for get()
+  static bool hs_finishing;
+#endif
+
 CardReader::CardReader() {
   changeMedia(&
     #if HAS_USB_FLASH_DRIVE && !SHARED_VOLUME_IS(SD_ONBOARD)
@@ -201,6 +237,7 @@ char *createFilename(char * const buffer, const dir_t &p) {
 
 //
 // Return 'true' if the item is a folder, G-code file or Binary file
+// (or a compressed G-code file with SDCARD_COMPRESSED_GCODE)
 //
 bool CardReader::is_visible_entity(const dir_t &p OPTARG(CUSTOM_FIRMWARE_UPLOAD, const bool onlyBin/*=false*/)) {
   //uint8_t pn0 = p.name[0];
@@ -226,6 +263,11 @@ bool CardReader::is_visible_entity(const dir_t &p OPTARG(CUSTOM_FIRMWARE_UPLOAD,
     || fileIsBinary()                                   // BIN files are accepted
     || (!onlyBin && p.name[8] == 'G'
                  && p.name[9] != '~')                   // Non-backup *.G* files are accepted
+    #if ENABLED(SDCARD_COMPRESSED_GCODE)
+      || (!onlyBin && p.name[8] == 'H'
+                   && p.name[9] == 'S'
+                   && p.name[10] == ' ')                // Compressed *.HS files are accepted
+    #endif
   );
 }
 
@@ -240,6 +282,29 @@ int16_t CardReader::countVisibleItems(MediaFile dir) {
   return c;
 }
 
+#if ENABLED(SDCARD_DIR_INDEX)
+
+  //
+  // Count the items in the working directory, noting the directory
+  // entry where each of the first SDCARD_DIR_INDEX_MAX is read from
+  //
+  int16_t CardReader::indexWorkDir() {
+    dir_t p;
+    int16_t c = 0;
+    workDir.rewind();
+    for (;;) {
+      const uint16_t entry = workDir.curPosition() >> 5;
+      if (workDir.readDir(&p, longFilename) <= 0) break;
+      if (is_visible_entity(p)) {
+        if (c < SDCARD_DIR_INDEX_MAX) dir_index[c] = entry;
+        c++;
+      }
+    }
+    return c;
+  }
+
+#endif
+
 //
 // Get file/folder info for an item by index
 //
@@ -623,7 +688,12 @@ void CardReader::endFilePrintNow(TERN_(SD_RESORT, const bool re_sort/*=false*/))
   TERN_(ADVANCED_PAUSE_FEATURE, did_pause_print = 0);
   TERN_(DWIN_CREALITY_LCD, hmiFlag.print_finish = flag.sdprinting);
   flag.abort_sd_printing = false;
-  if (isFileOpen()) file.close();
+  if (isFileOpen()) {
+    #if ENABLED(SDCARD_WRITE_BEHIND)
+      if (!wb_drain()) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+    #endif
+    file.close();
+  }
   TERN_(SD_RESORT, if (re_sort) presort());
 }
 
@@ -728,6 +798,14 @@ void CardReader::openFileRead(const char * const path, const uint8_t subcall_typ
   if (file.open(diveDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(SDCARD_FILE_EXTENTS, file.resolveExtents(file_extents, SDCARD_FILE_EXTENTS_MAX));
+    TERN_(SDCARD_READ_AHEAD, ra_seek(0));
+
+    #if ENABLED(SDCARD_COMPRESSED_GCODE)
+      const char * const ext = strrchr(fname, '.');
+      flag.compressed = ext && strcasecmp_P(ext, PSTR(".HS")) == 0;
+      if (flag.compressed) hs_start();
+    #endif
 
     { // Don't remove this block, as the PORT_REDIRECT is a RAII
       PORT_REDIRECT(SerialMask::All);
@@ -764,6 +842,8 @@ void CardReader::openFileWrite(const char * const path) {
   #if DISABLED(SDCARD_READONLY)
     if (file.open(diveDir, fname, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
       flag.saving = true;
+      nrItems = -1;
+      TERN_(SDCARD_COMPRESSED_GCODE, flag.compressed = false);
       selectFileByName(fname);
       TERN_(EMERGENCY_PARSER, emergency_parser.disable());
       echo_write_to_file(fname);
@@ -819,6 +899,7 @@ void CardReader::removeFile(const char * const name) {
     if (file.remove(itsDirPtr, fname)) {
       SERIAL_ECHOLNPGM("File deleted:", fname);
       sdpos = 0;
+      nrItems = -1;
       TERN_(SDCARD_SORT_ALPHA, presort());
     }
     else
@@ -828,7 +909,7 @@ void CardReader::removeFile(const char * const name) {
 
 void CardReader::report_status() {
   if (isPrinting() || isPaused()) {
-    SERIAL_ECHOPGM(STR_SD_PRINTING_BYTE, sdpos);
+    SERIAL_ECHOPGM(STR_SD_PRINTING_BYTE, readPosition());
     SERIAL_CHAR('/');
     SERIAL_ECHOLN(filesize);
   }
@@ -844,12 +925,13 @@ void CardReader::write_command(char * const buf) {
   file.writeError = false;
   if ((npos = strchr(buf, 'N'))) {
     begin = strchr(npos, ' ') + 1;
-    end = strchr(npos, '*') - 1;
+    char * const apos = strchr(npos, '*');  // Already cut if the line was parsed when queued
+    if (apos) end = apos - 1;
   }
   end[1] = '\r';
   end[2] = '\n';
   end[3] = '\0';
-  file.write(begin);
+  TERN(SDCARD_WRITE_BEHIND, wb_write(begin, strlen(begin)), file.write(begin));
 
   if (file.writeError) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
 }
@@ -973,6 +1055,9 @@ void CardReader::write_command(char * const buf) {
 #endif // ONE_CLICK_PRINT
 
 void CardReader::closefile(const bool store_location/*=false*/) {
+  #if ENABLED(SDCARD_WRITE_BEHIND)
+    if (!wb_drain()) SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+  #endif
   file.sync();
   file.close();
   flag.saving = flag.logging = false;
@@ -998,6 +1083,15 @@ void CardReader::selectFileByIndex(const int16_t nr) {
       return;
     }
   #endif
+  #if ENABLED(SDCARD_DIR_INDEX)
+    if (WITHIN(nr, 0, get_num_items() - 1)) {
+      // Start at the item, or at the last one indexed
+      const int16_t i = _MIN(nr, int16_t(SDCARD_DIR_INDEX_MAX - 1));
+      workDir.seekSet(uint32_t(dir_index[i]) << 5);
+      selectByIndex(workDir, nr - i);
+      return;
+    }
+  #endif
   workDir.rewind();
   selectByIndex(workDir, nr);
 }
@@ -1117,6 +1211,7 @@ const char* CardReader::diveToFile(const bool update_cwd, MediaFile* &inDirPtr,
     workDir = *inDirPtr;
     DEBUG_ECHOLNPGM(" final workDir = ", hex_address((void*)inDirPtr));
     flag.workDirIsRoot = (workDirDepth == 0);
+    nrItems = -1;
     TERN_(SDCARD_SORT_ALPHA, presort());
   }
 
@@ -1393,7 +1488,7 @@ void CardReader::cdroot() {
 
 int16_t CardReader::get_num_items() {
   if (!isMounted()) return 0;
-  if (nrItems < 0) nrItems = countVisibleItems(workDir);
+  if (nrItems < 0) nrItems = TERN(SDCARD_DIR_INDEX, indexWorkDir(), countVisibleItems(workDir));
   return nrItems;
 }
 
@@ -1418,6 +1513,242 @@ void CardReader::fileHasFinished() {
   marlin_state = MF_SD_COMPLETE;  // Tell Marlin to enqueue M1001 soon
 }
 
+#if ENABLED(SDCARD_COMPRESSED_GCODE)
+
+  //
+  // Start decompressing the open file from the beginning
+  //
+  void CardReader::hs_start() {
+    heatshrink_decoder_reset(&hsd);
+    IF_DISABLED(SDCARD_READ_AHEAD, hs_in_index = hs_in_count = 0);
+    hs_out_index = hs_out_count = 0;
+    hs_finishing = hs_eof = false;
+    sdpos = 0;
+    hs_fill();
+  }
+
+  //
+  // Decompress the next run of bytes into hs_out, reading the file as needed.
+  // Set hs_eof when nothing is left. Return false if nothing was decompressed.
+  //
+  bool CardReader::hs_fill() {
+    hs_out_index = hs_out_count = 0;
+    for (;;) {
+      size_t count;
+      heatshrink_decoder_poll(&hsd, hs_out, sizeof(hs_out), &count);
+      if (count) { hs_out_count = count; return true; }
+
+      #if ENABLED(SDCARD_READ_AHEAD)
+        if (ra_pos < ra_end || ra_next()) {             // Sink straight from the read-ahead buffer
+          heatshrink_decoder_sink(&hsd, ra_pos, ra_end - ra_pos, &count);
+          ra_pos += count;
+        }
+        else if (rawPosition() < filesize)
+          return false;                                 // Read error. get() returns -1.
+      #else
+        if (hs_in_index < hs_in_count) {                // The decoder wants more input
+          heatshrink_decoder_sink(&hsd, &hs_in[hs_in_index], hs_in_count - hs_in_index, &count);
+          hs_in_index += count;
+        }
+        else if (file.curPosition() < filesize) {       // Read more of the file
+          const int16_t n = file.read(hs_in, sizeof(hs_in));
+          if (n <= 0) return false;                     // Read error. get() returns -1.
+          hs_in_index = 0;
+          hs_in_count = n;
+        }
+      #endif
+      else if (!hs_finishing && heatshrink_decoder_finish(&hsd) == HSDR_FINISH_MORE)
+        hs_finishing = true;                            // Poll once more for the tail
+      else {
+        hs_eof = true;
+        return false;
+      }
+    }
+  }
+
+  //
+  // Get the next decompressed byte. Decompress ahead so eof() is
+  // true as soon as the last byte has been returned.
+  //
+  int16_t CardReader::hs_get() {
+    if (hs_out_index >= hs_out_count && !hs_fill()) return -1;
+    const uint8_t c = hs_out[hs_out_index++];
+    sdpos++;
+    if (hs_out_index >= hs_out_count) hs_fill();
+    return c;
+  }
+
+  //
+  // Seek to an index in the decompressed G-code. The stream can only
+  // be decompressed forward, so going back starts over from the top.
+  //
+  void CardReader::hs_seek(const uint32_t index) {
+    if (index < sdpos) {
+      rawSeek(0);
+      hs_start();
+    }
+    while (sdpos < index && hs_out_index < hs_out_count) {
+      const uint32_t skip = _MIN(index - sdpos, uint32_t(hs_out_count - hs_out_index));
+      hs_out_index += skip;
+      sdpos += skip;
+      if (hs_out_index >= hs_out_count) hs_fill();
+    }
+  }
+
+#endif // SDCARD_COMPRESSED_GCODE
+
+#if ENABLED(SDCARD_READ_AHEAD)
+
+  //
+  // Point get() at the data in the first buffered block
+  //
+  void CardReader::ra_point() {
+    uint8_t * const block = ra_buffer[ra_head];
+    ra_pos = block + ra_skip;
+    ra_end = block + _MIN(filesize - ra_offset, uint32_t(512));
+    ra_skip = 0;
+  }
+
+  //
+  // Read as many blocks as fit in the free part of the ring
+  // with one transfer. Return false on error or end of file.
+  //
+  bool CardReader::ra_fill() {
+    const bool empty = !ra_count;
+    if (empty) {
+      const uint32_t pos = file.curPosition();
+      if (pos & 0x1FF) ra_seek(pos);  // After read() left the file off a block boundary
+      ra_offset = file.curPosition();
+      ra_head = 0;
+    }
+    const uint8_t tail = (ra_head + ra_count) % SDCARD_READ_AHEAD_BLOCKS,
+                  room = _MIN(SDCARD_READ_AHEAD_BLOCKS - ra_count, SDCARD_READ_AHEAD_BLOCKS - tail);
+    if (!room) return true;
+    const int16_t n = file.readBlocks(ra_buffer[tail], room);
+    if (n <= 0) return false;
+    ra_count += n;
+    if (empty) ra_point();
+    return true;
+  }
+
+  //
+  // Move on to the next block once get() has used up the first one
+  //
+  bool CardReader::ra_next() {
+    if (ra_count) {
+      ra_offset += 512;
+      if (--ra_count) {
+        ra_head = (ra_head + 1) % SDCARD_READ_AHEAD_BLOCKS;
+        ra_point();
+        return ra_pos < ra_end;
+      }
+    }
+    return ra_fill() && ra_pos < ra_end;
+  }
+
+  //
+  // Drop the buffer and seek to a file position. The file itself is
+  // left on a block boundary and the rest is skipped when it's read.
+  //
+  void CardReader::ra_seek(const uint32_t pos) {
+    ra_count = 0;
+    ra_pos = ra_end = nullptr;
+    ra_skip = pos & 0x1FF;
+    file.seekSet(pos - ra_skip);
+  }
+
+  //
+  // Drop the buffer and put the file where get() left off, for read()
+  //
+  void CardReader::ra_sync() {
+    if (!ra_count && !ra_skip) return;
+    const uint32_t pos = rawPosition();
+    ra_seek(pos);
+    ra_skip = 0;
+    file.seekSet(pos);
+  }
+
+  //
+  // Refill the buffer while printing, so get() rarely has to wait for the card.
+  // Wait for half of it to be free so each refill is a multiple block read.
+  //
+  void CardReader::readAhead() {
+    if (ra_count <= (SDCARD_READ_AHEAD_BLOCKS) / 2 && IS_SD_FETCHING()) ra_fill();
+  }
+
+#endif // SDCARD_READ_AHEAD
+
+#if ENABLED(SDCARD_WRITE_BEHIND)
+
+  //
+  // Add data to the ring. A file that doesn't start on a block boundary
+  // is written directly up to one. A full ring is written out at once.
+  //
+  int16_t CardReader::wb_write(const void *buf, uint16_t nbyte) {
+    const uint8_t *src = (const uint8_t*)buf;
+    const int16_t total = nbyte;
+    if (!wb_count && !wb_fill) {
+      const uint16_t part = _MIN(nbyte, uint16_t((512 - (file.curPosition() & 0x1FF)) & 0x1FF));
+      if (part) {
+        if (file.write(src, part) < 0) return -1;
+        src += part;
+        nbyte -= part;
+      }
+    }
+    while (nbyte) {
+      uint8_t * const block = wb_buffer[(wb_head + wb_count) % SDCARD_WRITE_BEHIND_BLOCKS];
+      const uint16_t n = _MIN(nbyte, uint16_t(512 - wb_fill));
+      memcpy(block + wb_fill, src, n);
+      src += n;
+      nbyte -= n;
+      wb_fill += n;
+      if (wb_fill == 512) {
+        wb_fill = 0;
+        if (++wb_count == SDCARD_WRITE_BEHIND_BLOCKS && !wb_flush()) return -1;
+      }
+    }
+    return total;
+  }
+
+  //
+  // Write out the full blocks, as few transfers as the ring and the
+  // file's clusters allow. On error the buffered data is dropped.
+  //
+  bool CardReader::wb_flush() {
+    while (wb_count) {
+      const uint8_t room = SDCARD_WRITE_BEHIND_BLOCKS - wb_head;
+      const int16_t n = file.writeBlocks(wb_buffer[wb_head], _MIN(wb_count, room));
+      if (n <= 0) {
+        wb_head = wb_count = wb_fill = 0;
+        return false;
+      }
+      wb_head = (wb_head + n) % SDCARD_WRITE_BEHIND_BLOCKS;
+      wb_count -= n;
+    }
+    return true;
+  }
+
+  //
+  // Write out everything, the partial last block included, before closing
+  //
+  bool CardReader::wb_drain() {
+    if (!wb_flush()) return false;
+    const uint16_t n = wb_fill;
+    wb_fill = 0;
+    return !n || file.write(wb_buffer[wb_head], n) >= 0;
+  }
+
+  //
+  // Write out the buffer while saving, once half of it is full, so
+  // uploads only wait for the card when the ring fills up.
+  //
+  void CardReader::writeBehind() {
+    if (wb_count >= (SDCARD_WRITE_BEHIND_BLOCKS) / 2 && !wb_flush())
+      SERIAL_ERROR_MSG(STR_SD_ERR_WRITE_TO_FILE);
+  }
+
+#endif // SDCARD_WRITE_BEHIND
+
 #if ENABLED(AUTO_REPORT_SD_STATUS)
   AutoReporter<CardReader::AutoReportSD> CardReader::auto_reporter;
 #endif
@@ -83,6 +83,9 @@ typedef struct {
        #if ENABLED(BINARY_FILE_TRANSFER)
          , binary_mode:1
        #endif
+       #if ENABLED(SDCARD_COMPRESSED_GCODE)
+         , compressed:1
+       #endif
     ;
 } card_flags_t;
 
@@ -177,13 +180,13 @@ public:
   #if HAS_PRINT_PROGRESS_PERMYRIAD
     static uint16_t permyriadDone() {
       if (flag.sdprintdone) return 10000;
-      if (isFileOpen() && filesize) return sdpos / ((filesize + 9999) / 10000);
+      if (isFileOpen() && filesize) return readPosition() / ((filesize + 9999) / 10000);
       return 0;
     }
   #endif
   static uint8_t percentDone() {
     if (flag.sdprintdone) return 100;
-    if (isFileOpen() && filesize) return sdpos / ((filesize + 99) / 100);
+    if (isFileOpen() && filesize) return readPosition() / ((filesize + 99) / 100);
     return 0;
   }
 
@@ -225,6 +228,9 @@ public:
   static bool fileIsBinary() { return TERN0(DO_LIST_BIN_FILES, flag.filenameIsBin); }
   static void setBinFlag(const bool bin) { TERN(DO_LIST_BIN_FILES, flag.filenameIsBin = bin, UNUSED(bin)); }
 
+  // Heatshrink-compressed G-code (*.HS) is decompressed by get()
+  static bool fileIsCompressed() { return TERN0(SDCARD_COMPRESSED_GCODE, flag.compressed); }
+
   // Current Working Dir - Set by cd, cdup, cdroot, and diveToFile(true, ...)
   static char* getWorkDirName()  { workDir.getDosName(filename); return filename; }
   static MediaFile& getWorkDir()    { return workDir.isOpen() ? workDir : root; }
@@ -233,17 +239,58 @@ public:
   static uint32_t getFileSize()  { return filesize; }
   static uint32_t getIndex()     { return sdpos; }
   static bool isFileOpen()       { return isMounted() && file.isOpen(); }
-  static bool eof()              { return getIndex() >= getFileSize(); }
+  static bool eof() {
+    #if ENABLED(SDCARD_COMPRESSED_GCODE)
+      if (flag.compressed) return hs_eof;
+    #endif
+    return getIndex() >= getFileSize();
+  }
+
+  // Bytes read from the file itself, for progress. Compressed files are behind sdpos.
+  static uint32_t readPosition() { return fileIsCompressed() ? rawPosition() : sdpos; }
 
   // File data operations
-  static int16_t get()                            { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
-  static int16_t read(void *buf, uint16_t nbyte)  { return file.isOpen() ? file.read(buf, nbyte) : -1; }
-  static int16_t write(void *buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
-  static void setIndex(const uint32_t index)      { file.seekSet((sdpos = index)); }
+  static int16_t get() {
+    #if ENABLED(SDCARD_COMPRESSED_GCODE)
+      if (flag.compressed) return hs_get();
+    #endif
+    #if ENABLED(SDCARD_READ_AHEAD)
+      if (ra_pos >= ra_end && !ra_next()) return -1;
+      sdpos++;
+      return *ra_pos++;
+    #else
+      int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out;
+    #endif
+  }
+  static int16_t read(void *buf, uint16_t nbyte) {
+    TERN_(SDCARD_READ_AHEAD, ra_sync());
+    return file.isOpen() ? file.read(buf, nbyte) : -1;
+  }
+  static int16_t write(void *buf, uint16_t nbyte) {
+    if (!file.isOpen()) return -1;
+    return TERN(SDCARD_WRITE_BEHIND, wb_write(buf, nbyte), file.write(buf, nbyte));
+  }
+  static void setIndex(const uint32_t index) {
+    #if ENABLED(SDCARD_COMPRESSED_GCODE)
+      if (flag.compressed) return hs_seek(index);
+    #endif
+    rawSeek((sdpos = index));
+  }
+
+  #if ENABLED(SDCARD_READ_AHEAD)
+    static void readAhead();
+  #endif
+  #if ENABLED(SDCARD_WRITE_BEHIND)
+    static void writeBehind();
+  #endif
 
   // TODO: rename to diskIODriver()
   static DiskIODriver* diskIODriver() { return driver; }
 
+  #if ENABLED(SDCARD_BLOCK_CACHE)
+    static cache_stats_t& cacheStats() { return volume.cacheStats(); }
+  #endif
+
   #if ENABLED(AUTO_REPORT_SD_STATUS)
     //
     // SD Auto Reporting
@@ -270,6 +317,11 @@ private:
   static uint8_t workDirDepth;
   static int16_t nrItems; // Cache the total count
 
+  #if ENABLED(SDCARD_DIR_INDEX)
+    static uint16_t dir_index[SDCARD_DIR_INDEX_MAX];  // Directory entry of each item, valid with nrItems
+    static int16_t indexWorkDir();
+  #endif
+
   //
   // Alphabetical file and folder sorting
   //
@@ -332,6 +384,58 @@ private:
   static uint32_t filesize, // Total size of the current file, in bytes
                   sdpos;    // Index most recently read (one behind file.getPos)
 
+  //
+  // Read-ahead of the open file, a ring of whole blocks filled
+  // by multiple block reads while printing. get() reads from it.
+  //
+  #if ENABLED(SDCARD_READ_AHEAD)
+    static uint8_t ra_buffer[SDCARD_READ_AHEAD_BLOCKS][512];
+    static uint8_t ra_head, ra_count;   // First buffered block and number of blocks buffered
+    static uint32_t ra_offset;          // File position of the first buffered block
+    static uint16_t ra_skip;            // Bytes to skip in the next block read, after a seek
+    static uint8_t *ra_pos, *ra_end;    // Next byte and end of data in the first block
+    static void ra_point();
+    static bool ra_fill();
+    static bool ra_next();
+    static void ra_seek(const uint32_t pos);
+    static void ra_sync();
+  #endif
+
+  //
+  // Write-behind of the file being saved, a ring of blocks filled by
+  // write() and written out by multiple block writes from idle().
+  //
+  #if ENABLED(SDCARD_WRITE_BEHIND)
+    static uint8_t wb_buffer[SDCARD_WRITE_BEHIND_BLOCKS][512];
+    static uint8_t wb_head, wb_count;   // First buffered block and number of full blocks
+    static uint16_t wb_fill;            // Bytes in the block after the full ones
+    static int16_t wb_write(const void *buf, uint16_t nbyte);
+    static bool wb_flush();
+    static bool wb_drain();
+  #endif
+
+  // Position in the file itself, the read-ahead buffer included
+  static uint32_t rawPosition() {
+    #if ENABLED(SDCARD_READ_AHEAD)
+      return ra_count ? ra_offset + (ra_pos - ra_buffer[ra_head]) : file.curPosition() + ra_skip;
+    #else
+      return file.curPosition();
+    #endif
+  }
+  static void rawSeek(const uint32_t pos) { TERN(SDCARD_READ_AHEAD, ra_seek(pos), file.seekSet(pos)); }
+
+  //
+  // Heatshrink decompression of *.HS files
+  // For these sdpos is the index in the decompressed G-code
+  //
+  #if ENABLED(SDCARD_COMPRESSED_GCODE)
+    static bool hs_eof;       // The last decompressed byte has been read
+    static void hs_start();
+    static bool hs_fill();
+    static int16_t hs_get();
+    static void hs_seek(const uint32_t index);
+  #endif
+
   //
   // Procedure calls to other files
   //
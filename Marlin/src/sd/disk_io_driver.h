@@ -60,6 +60,35 @@ public:
   virtual bool readBlock(const uint32_t block, uint8_t * const dst) = 0;
   virtual bool writeBlock(const uint32_t blockNumber, const uint8_t * const src) = 0;
 
+  /**
+   * Read consecutive blocks in one multiple block transfer.
+   * Drivers with a faster way to do this should override it.
+   *
+   * \return true for success or false for failure.
+   */
+  virtual bool readBlocks(const uint32_t block, uint8_t *dst, const uint8_t count) {
+    if (count == 1) return readBlock(block, dst);
+    if (!readStart(block)) return false;
+    bool success = true;
+    for (uint8_t i = 0; success && i < count; ++i, dst += 512) success = readData(dst);
+    return readStop() && success;
+  }
+
+  /**
+   * Write consecutive blocks in one multiple block transfer,
+   * pre-erasing them first. Drivers with a faster way to do
+   * this should override it.
+   *
+   * \return true for success or false for failure.
+   */
+  virtual bool writeBlocks(const uint32_t block, const uint8_t *src, const uint8_t count) {
+    if (count == 1) return writeBlock(block, src);
+    if (!writeStart(block, count)) return false;
+    bool success = true;
+    for (uint8_t i = 0; success && i < count; ++i, src += 512) success = writeData(src);
+    return writeStop() && success;
+  }
+
   virtual uint32_t cardSize() = 0;
 
   virtual bool isReady() = 0;
@@ -31,9 +31,208 @@
 #include "../module/stepper.h"
 #include "../module/temperature.h"
 
+#if ENABLED(FAST_NUMBER_PARSER)
+  #include "../libs/strtonum.h"
+#endif
+
+#if ENABLED(COMMAND_ARENA)
+  #include "../gcode/queue.h"
+#endif
+
+#if ENABLED(STEP_COMPILER_CHECK)
+  #include "../feature/step_compiler.h"
+#endif
+
 // Individual tests are localized in each module.
 // Each test produces its own report.
 
+#if ENABLED(FAST_NUMBER_PARSER)
+
+  /**
+   * Compare dectof with strtof, and dectofix with rounded strtod, over
+   * random G-code numbers. Some have a sign, leading zeros, no integer
+   * or fraction digits, or a following 'E' or 'X' that must be ignored.
+   */
+  static void testNumberParser() {
+    #ifdef __PLAT_LINUX__
+      constexpr uint32_t count = 4000000UL;
+    #else
+      constexpr uint32_t count = 20000UL;
+    #endif
+
+    uint32_t seed = 0x1234567;
+    auto rnd = [&](const uint8_t n) {
+      seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+      return uint8_t(seed % n);
+    };
+
+    uint32_t exact = 0, float_fails = 0, fixed_fails = 0;
+    char str[40], num[40];
+    for (uint32_t n = 0; n < count; ++n) {
+      // [-+]?[0-9]{0,8}(.[0-9]{0,14})? with at least one digit
+      char *p = str;
+      switch (rnd(4)) { case 0: *p++ = '-'; break; case 1: *p++ = '+'; break; }
+      const uint8_t int_digits = rnd(9), frac_digits = rnd(15);
+      for (uint8_t i = 0; i < int_digits; ++i) *p++ = '0' + rnd(10);
+      if (frac_digits || rnd(2)) {
+        *p++ = '.';
+        for (uint8_t i = 0; i < frac_digits; ++i) *p++ = '0' + rnd(10);
+      }
+      if (!int_digits && !frac_digits) *p++ = '0' + rnd(10);
+      const uint8_t len = p - str;
+      strcpy(p, rnd(2) ? " X1" : "E5");
+
+      // The number alone, for the reference parsers
+      strncpy(num, str, len);
+      num[len] = '\0';
+
+      // Count significant digits
+      uint8_t digits = 0;
+      for (const char *c = num; *c; ++c) if (NUMERIC(*c) && (digits || *c != '0')) ++digits;
+
+      const float f = dectof(str), r = strtof(num, nullptr);
+      int32_t fi, ri;
+      memcpy(&fi, &f, sizeof(fi));
+      memcpy(&ri, &r, sizeof(ri));
+      const int32_t ulp = ABS(fi - ri);
+      if (!ulp)
+        exact++;
+      else if (ulp > (frac_digits > 10 ? 2 : digits > 7 ? 1 : 0)) {
+        if (float_fails++ < 5) SERIAL_ECHOLNPGM("dectof(", num, ") = ", p_float_t(f, 9), " strtof = ", p_float_t(r, 9));
+      }
+
+      // Skip values out of range and those too close to a tie for a double
+      const double d = strtod(num, nullptr) * 1000.0, frac = ABS(d - trunc(d));
+      if (ABS(d) < 2e9 && ABS(frac - 0.5) > 1e-3) {
+        const int32_t x = dectofix(str, 3);
+        if (x != int32_t(lround(d)) && fixed_fails++ < 5)
+          SERIAL_ECHOLNPGM("dectofix(", num, ", 3) = ", x, " strtod = ", p_float_t(d, 3));
+      }
+    }
+
+    SERIAL_ECHOLNPGM("Number parser: ", count, " numbers, ", exact, " same as strtof, ",
+      float_fails, " float failures, ", fixed_fails, " fixed-point failures"
+    );
+  }
+
+#endif // FAST_NUMBER_PARSER
+
+#if ENABLED(COMMAND_ARENA)
+
+  /**
+   * Assemble lines a few characters at a time while queued lines are
+   * released, as when serial input arrives while commands run. Every line
+   * must fit inside the arena and still hold its characters when released.
+   */
+  static void testCommandArena() {
+    constexpr uint32_t count = 200000UL;
+    constexpr uint8_t max_queued = 32;
+
+    uint32_t seed = 0x2468ACE;
+    auto rnd = [&](const uint8_t n) {
+      seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+      return uint8_t(seed % n);
+    };
+
+    static GCodeQueue::CommandArena a;
+    a.head = a.tail = a.wrap = 0;
+    a.queued = 0;
+
+    // Queued lines, oldest first, with the character each one is filled with
+    struct { const char *line; uint8_t len; char fill; } q[max_queued];
+    uint8_t q_r = 0, q_len = 0;
+
+    bool assembling = false;
+    uint8_t len = 0, target = 0;
+    char fill = 'A';
+    uint32_t lines = 0, overruns = 0, corrupted = 0;
+
+    for (uint32_t n = 0; n < count; ++n) {
+      // Commands run slower or faster than lines arrive, changing every 1024 steps
+      const uint8_t r = rnd(16);
+      if (r < ((n >> 10) & 15)) {
+        // Release the oldest line
+        if (q_len) {
+          const auto &c = q[q_r];
+          bool ok = c.line[c.len] == '\0';
+          for (uint8_t i = 0; ok && i < c.len; ++i) ok = c.line[i] == c.fill;
+          if (!ok) corrupted++;
+          a.release(c.len);
+          q_r = (q_r + 1) % max_queued;
+          q_len--;
+        }
+      }
+      else if (r == 15 && !rnd(100)) {
+        // Drop the whole queue, as queue.clear() does
+        a.reset();
+        q_len = 0;
+      }
+      else {
+        // Receive a few characters
+        if (!assembling) {
+          if (q_len >= max_queued || !a.reserve()) continue;
+          if (a.tail + (MAX_CMD_SIZE) > (COMMAND_ARENA_SIZE)) { overruns++; continue; }
+          assembling = true;
+          len = 0;
+          target = 1 + rnd((MAX_CMD_SIZE) - 1);
+          fill = 'A' + rnd(26);
+        }
+        for (uint8_t i = rnd(16); i && len < target; --i) a.line()[len++] = fill;
+        if (len == target) {
+          a.line()[len] = '\0';
+          q[(q_r + q_len) % max_queued] = { a.commit(len), len, fill };
+          q_len++;
+          lines++;
+          assembling = false;
+        }
+      }
+    }
+
+    SERIAL_ECHOLNPGM("Command arena: ", lines, " lines, ", overruns, " overruns, ", corrupted, " corrupted lines");
+  }
+
+#endif // COMMAND_ARENA
+
+#if ENABLED(STEP_COMPILER_CHECK) && defined(__PLAT_LINUX__)
+
+  /**
+   * Run moves of random length and direction and have the Stepper compare
+   * every compiled step event with the live line tracer. Some moves are
+   * longer than a table, so the tracer takes over part-way. The axes move,
+   * so this only runs on the simulator.
+   */
+  static void testStepCompiler() {
+    constexpr uint8_t count = 60;
+
+    uint32_t seed = 0x13579BD;
+    auto rnd = [&](const uint8_t n) {
+      seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+      return uint8_t(seed % n);
+    };
+
+    const uint32_t checked_before = StepCompiler::checked_events,
+                   mismatches_before = StepCompiler::mismatches;
+
+    const xyze_pos_t start = current_position;
+    xyze_pos_t pos = start;
+    for (uint8_t n = 0; n < count; ++n) {
+      // Between a few steps and a few thousand, on one to three axes
+      pos.x = start.x + rnd(200) * 0.05f;
+      if (rnd(2)) pos.y = start.y + rnd(200) * 0.05f;
+      if (!rnd(4)) pos.z = start.z + rnd(20) * 0.05f;
+      planner.buffer_line(pos, 50 + rnd(100));
+    }
+    planner.buffer_line(start, 100);
+    planner.synchronize();
+
+    const uint32_t checked = StepCompiler::checked_events - checked_before,
+                   mismatches = StepCompiler::mismatches - mismatches_before;
+    SERIAL_ECHOLNPGM("Step compiler: ", checked, " events checked, ", mismatches, " mismatches");
+    if (!checked || mismatches) SERIAL_ERROR_MSG("Step compiler test FAILED");
+  }
+
+#endif // STEP_COMPILER_CHECK
+
 // Startup tests are run at the end of setup()
 void runStartupTests() {
   // Call post-setup tests here to validate behaviors.
@@ -72,6 +271,11 @@ void runStartupTests() {
   auto print_char_ptr = [](char * const str) { SERIAL_ECHOLN(str); };
   print_char_ptr(str);
 
+  TERN_(FAST_NUMBER_PARSER, testNumberParser());
+  TERN_(COMMAND_ARENA, testCommandArena());
+  #if ENABLED(STEP_COMPILER_CHECK) && defined(__PLAT_LINUX__)
+    testStepCompiler();
+  #endif
 }
 
 // Periodic tests are run from within loop()
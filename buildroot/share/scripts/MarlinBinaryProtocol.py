@@ -1,6 +1,7 @@
 #
 # MarlinBinaryProtocol.py
 # Supporting Firmware upload via USB/Serial, saving to the attached media.
+# MotionProtocol streams packed G0-G3 moves (BINARY_MOTION_STREAM).
 #
 import serial
 import math
@@ -442,6 +443,91 @@ class FileTransferProtocol(object):
         return True
 
 
+class MotionProtocol(object):
+    """
+    Stream G0-G3 moves as packed records (BINARY_MOTION_STREAM).
+    Moves are batched until a packet is full, so each ack covers many moves.
+    """
+    protocol_id = 2
+
+    class Packet(object):
+        QUERY = 0
+        MOVE  = 1
+
+    responses = deque()
+    def __init__(self, protocol, timeout = None):
+        protocol.register(['PMS:version:', 'PMS:invalid'], self.process_input)
+        self.protocol = protocol
+        self.response_timeout = timeout or protocol.response_timeout
+        self.batch = bytearray()
+
+    def process_input(self, data):
+        self.responses.append(data)
+
+    def connect(self):
+        self.protocol.send(MotionProtocol.protocol_id, MotionProtocol.Packet.QUERY)
+        timeout = TimeOut(self.response_timeout)
+        while not len(self.responses):
+            time.sleep(0.0001)
+            if timeout.timedout():
+                raise ReadTimeout()
+        token, data = self.responses.popleft()
+        if token != 'PMS:version:':
+            return False
+
+        # e.g., "0.1.0:units:1000:arcs:1:position:X0,Y0,Z0,E0"
+        fields = data.split(':')
+        self.version = fields[0]
+        self.units = int(fields[2])
+        self.arcs = fields[4] == '1'
+        self.axes = [ v[0] for v in fields[6].split(',') ]
+        self.position = { v[0]: int(v[1:]) for v in fields[6].split(',') }
+        print("Motion Stream version: {0}, axes: {1}, arcs: {2}".format(self.version, ''.join(self.axes), self.arcs))
+        return True
+
+    def pack_varint(self, value):
+        out = bytearray()
+        while True:
+            b = value & 0x7F
+            value >>= 7
+            if value:
+                out.append(b | 0x80)
+            else:
+                out.append(b)
+                return out
+
+    def pack_zigzag(self, value):
+        return self.pack_varint(value << 1 if value >= 0 else (-value << 1) - 1)
+
+    def encode(self, code, axes, feedrate = None, offset = None):
+        """Encode one move. 'axes' maps axis letters to absolute positions in mm."""
+        mask, deltas = 0, bytearray()
+        for n, axis in enumerate(self.axes):
+            if axis not in axes: continue
+            target = int(round(axes[axis] * self.units))
+            if target == self.position[axis]: continue
+            mask |= 1 << n
+            deltas += self.pack_zigzag(target - self.position[axis])
+            self.position[axis] = target
+        record = bytearray([ (code & 3) | (4 if feedrate else 0) ]) + self.pack_varint(mask) + deltas
+        if feedrate: record += self.pack_varint(int(round(feedrate)))
+        if code >= 2:
+            record += self.pack_zigzag(int(round(offset[0] * self.units)))
+            record += self.pack_zigzag(int(round(offset[1] * self.units)))
+        return record
+
+    def move(self, code, axes, feedrate = None, offset = None):
+        record = self.encode(code, axes, feedrate, offset)
+        if len(self.batch) + len(record) > self.protocol.block_size:
+            self.flush()
+        self.batch += record
+
+    def flush(self):
+        if len(self.batch):
+            self.protocol.send(MotionProtocol.protocol_id, MotionProtocol.Packet.MOVE, self.batch)
+            self.batch = bytearray()
+
+
 class EchoProtocol(object):
     def __init__(self, protocol):
         protocol.register(['echo:'], self.process_input)
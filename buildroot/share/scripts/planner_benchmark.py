@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+#
+# planner_benchmark.py
+#
+# Replay a G-code file through a PLANNER_BENCHMARK build (linux_native_benchmark)
+# and print the M960 report. Lines are streamed to stdin as fast as the firmware
+# accepts them, so the planner and the G-code handlers are the only limit on
+# throughput. The "command" stage is the time to parse and run each command.
+#
+#   pio run -e linux_native_benchmark
+#   planner_benchmark.py .pio/build/linux_native_benchmark/program job.gcode
+#
+# To check that a planner change gives the same motion, save the trapezoid
+# of every block from one build and compare another build against it:
+#
+#   planner_benchmark.py float/program job.gcode --trace float.txt
+#   planner_benchmark.py fixed/program job.gcode --trace fixed.txt --compare float.txt
+#
+# To compare plain text with MeatPack, build with MEATPACK_ON_SERIAL_PORT_1
+# (and without BINARY_FILE_TRANSFER) and run the same file with and without
+# --meatpack. The "serial" stage is the time spent reading and decoding input,
+# and the input rates are in bytes as sent over the wire.
+#
+import argparse, re, subprocess, sys, threading
+
+STAGES = 7  # Lines following the "Planner Benchmark:" header
+
+# MeatPack packs two characters from this table into one byte. 0xF marks a literal.
+# With no-spaces on, spaces are dropped and 'E' takes their place in the table.
+MP_TABLE = '0123456789. \nGX'
+MP_START = b'\xff\xff\xfb\xff\xff\xf7'  # Enable packing, then no-spaces
+
+def meatpack(line):
+    '''Pack a line (ending in a newline) the way the MeatPack host plugin does.'''
+    table = MP_TABLE.replace(' ', 'E')
+    line = line.replace(' ', '')
+    if len(line) % 2: line += '0'   # Nothing after a packed newline is used
+    out = bytearray()
+    for a, b in zip(line[0::2], line[1::2]):
+        ia, ib = table.find(a), table.find(b)
+        ia, ib = (ia if ia >= 0 else 0xF), (ib if ib >= 0 else 0xF)
+        out.append(ia | ib << 4)
+        if ia == 0xF: out.append(ord(a))
+        if ib == 0xF: out.append(ord(b))
+    return bytes(out)
+
+# Homing and probing can't complete when nothing is stepped
+SKIP = ('G28', 'G29', 'G30', 'G34', 'M48')
+
+# Fields of the M960 T "TRAP:" lines
+TRAP_FIELDS = ('steps', 'initial_rate', 'final_rate', 'accelerate_until', 'decelerate_after',
+               'cruise_rate', 'acceleration_time', 'deceleration_time')
+
+def time_limit(t, name, tolerance):
+    '''
+    Allowed difference in an S-Curve time, or None to ignore the field. A rate
+    that is off by one changes the time by the ticks per unit of rate.
+    '''
+    if name == 'acceleration_time':
+        if t['accelerate_until'] == 0: return None
+        dv = t['cruise_rate'] - t['initial_rate']
+    else:
+        if t['decelerate_after'] >= t['steps']: return None
+        dv = t['cruise_rate'] - t['final_rate']
+    return tolerance * (t[name] // dv + 1) if dv > 0 else None
+
+def compare(ref_file, traps, tolerance):
+    '''
+    Compare the traced blocks with a reference trace. Step counts and rates may
+    differ by 'tolerance' and times by the equivalent. Return True if they match.
+    '''
+    with open(ref_file) as f:
+        ref = [ line.strip() for line in f if line.startswith('TRAP:') ]
+    if len(ref) != len(traps):
+        print(f'Block count differs: {len(traps)} vs. {len(ref)} in {ref_file}')
+        return False
+
+    worst = {}  # field : (max difference, blocks over tolerance)
+    for a, b in zip(traps, ref):
+        ta = dict(zip(TRAP_FIELDS, map(int, a[5:].split(','))))
+        tb = dict(zip(TRAP_FIELDS, map(int, b[5:].split(','))))
+        for name in ta:
+            limit = time_limit(tb, name, tolerance) if name.endswith('_time') else tolerance
+            if limit is None: continue  # Phase not used by the stepper
+            diff = abs(ta[name] - tb[name])
+            most, over = worst.get(name, (0, 0))
+            worst[name] = (max(most, diff), over + (diff > limit))
+
+    ok = True
+    for name, (most, over) in worst.items():
+        print(f'{name:>18} max_diff:{most} over_tolerance:{over}')
+        if over: ok = False
+    print(f'{len(traps)} blocks {"match" if ok else "DIFFER"}')
+    return ok
+
+def main():
+    ap = argparse.ArgumentParser(description='Replay G-code through the Marlin planner and report timings.')
+    ap.add_argument('program', help='linux_native_benchmark executable')
+    ap.add_argument('gcode', help='G-code file to replay')
+    ap.add_argument('--prelude', nargs='*', default=['M302 P1', 'G92 X0 Y0 Z0 E0'],
+                    help='G-code sent before the file. Default allows cold extrusion and sets the origin.')
+    ap.add_argument('--trace', help='Save the trapezoid of every block to this file (timings will be skewed)')
+    ap.add_argument('--compare', help='Compare the traced blocks with a file saved by --trace')
+    ap.add_argument('--tolerance', type=int, default=1, help='Allowed difference in steps and rates (default 1)')
+    ap.add_argument('--meatpack', action='store_true', help='Send the file MeatPacked (needs MEATPACK_ON_SERIAL_PORT_1)')
+    args = ap.parse_args()
+    if args.compare and not args.trace: ap.error('--compare requires --trace')
+
+    proc = subprocess.Popen([args.program], stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1)
+
+    sent = [0, 0]  # Bytes and lines of the file, as sent
+
+    def feed():
+        out = proc.stdin.buffer
+        def send(line, pack=False):
+            line = line.split(';', 1)[0].strip()
+            if line.startswith(SKIP) or not line: return
+            data = meatpack(line + '\n') if pack else (line + '\n').encode()
+            out.write(data)
+            return len(data)
+        for line in args.prelude: send(line)
+        send('M960 S R' + (' T1' if args.trace else ''))  # Reset counters after startup moves
+        if args.meatpack: out.write(MP_START)
+        with open(args.gcode) as f:
+            for line in f:
+                n = send(line, args.meatpack)
+                if n: sent[0] += n; sent[1] += 1
+        send('M960', args.meatpack)
+        out.flush()
+
+    # Feed from a thread so "ok" output can't back up and stall the firmware
+    threading.Thread(target=feed, daemon=True).start()
+
+    traps = []
+    report = None  # Indented lines following the header
+    try:
+        for line in proc.stdout:
+            if report is None:
+                if line.startswith('TRAP:'):
+                    traps.append(line.strip())
+                elif line.startswith('Planner Benchmark:'):
+                    header = line.rstrip()
+                    print(header)
+                    report = []
+            elif line.startswith(' '):
+                print(line.rstrip())
+                report.append(line)
+            else:
+                break
+    except BrokenPipeError:
+        pass
+    finally:
+        proc.kill()
+
+    if report is None or len(report) < STAGES: return 1
+
+    # Input rates, in bytes as sent
+    secs = float(re.search(r' time:([\d.]+)s', header).group(1))
+    m = re.search(r' serial calls:(\d+) avg_ns:(\d+)', ''.join(report))
+    serial_secs = int(m.group(1)) * int(m.group(2)) * 1e-9 if m else 0
+    print(f'Input: {sent[0]} bytes in {sent[1]} lines{" (MeatPack)" if args.meatpack else ""}'
+          f' bytes/s:{sent[0] / secs if secs else 0:.0f}'
+          f' serial bytes/s:{sent[0] / serial_secs if serial_secs else 0:.0f}')
+
+    if args.trace:
+        with open(args.trace, 'w') as f:
+            for t in traps: f.write(t + '\n')
+        if args.compare and not compare(args.compare, traps, args.tolerance):
+            return 1
+
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
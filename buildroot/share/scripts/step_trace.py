@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# step_trace.py
+#
+# Analyze step traces recorded by the LINUX HAL (linux_native_trace), which
+# writes every step with its time and direction to step_trace.bin.
+#
+#   step_trace.py info    trace.bin
+#   step_trace.py profile trace.bin [--csv profile.csv]
+#   step_trace.py compare before.bin after.bin [--tolerance 5]
+#
+# 'profile' reports the peak velocity, acceleration and jerk of each axis.
+# Steps are counted into bins of --bin ms, and each derivative is a central
+# difference over --window bins to smooth out step quantization. Put
+# --steps-per-mm 80,80,400,93 before the command to report in mm.
+#
+# 'compare' lines up two traces at their first step and reports how the
+# profiles differ. It fails if an axis ends at a different position, or if
+# a peak differs by more than --tolerance percent.
+#
+import argparse, struct, sys
+from array import array
+
+MAGIC = b'MSTRACE\0'
+HEADER = struct.Struct('<8sIIQ8s32x')
+
+class Trace:
+    '''Steps of one trace, as a sorted list of (time_ns, delta) per axis.'''
+    def __init__(self, filename):
+        with open(filename, 'rb') as f:
+            data = f.read()
+        magic, version, axes, count, names = HEADER.unpack_from(data)
+        if magic != MAGIC: sys.exit(f'{filename}: not a step trace')
+        if version != 1: sys.exit(f'{filename}: unsupported version {version}')
+        self.names = names.rstrip(b'\0').decode()[:axes]
+        records = array('Q')
+        records.frombytes(data[HEADER.size:HEADER.size + count * 8])
+        if sys.byteorder != 'little': records.byteswap()
+
+        self.steps = [ [] for _ in range(axes) ]
+        for r in records:
+            self.steps[(r >> 1) & 0x7F].append((r >> 8, 1 if r & 1 else -1))
+        self.start = min((s[0][0] for s in self.steps if s), default=0)
+        self.end = max((s[-1][0] for s in self.steps if s), default=0)
+        self.count = count
+
+    def net(self, axis):
+        return sum(d for _, d in self.steps[axis])
+
+def profile(trace, axis, bin_ns, window, scale, start=None):
+    '''
+    Position, velocity, acceleration and jerk of an axis in bins of bin_ns,
+    beginning at 'start'. Units are steps or mm (scale = 1 / steps-per-mm) and seconds.
+    '''
+    start = trace.start if start is None else start
+    nbins = (trace.end - start) // bin_ns + 2
+    pos = [0.0] * nbins
+    for t, d in trace.steps[axis]:
+        pos[(t - start) // bin_ns] += d * scale
+    for k in range(1, nbins): pos[k] += pos[k - 1]
+
+    span = 2 * window * bin_ns / 1e9
+    def deriv(x):
+        n = len(x)
+        return [ (x[min(k + window, n - 1)] - x[max(k - window, 0)]) / span for k in range(n) ]
+
+    vel = deriv(pos)
+    acc = deriv(vel)
+    jerk = deriv(acc)
+    return pos, vel, acc, jerk
+
+def rms(x):
+    return (sum(v * v for v in x) / len(x)) ** 0.5 if x else 0.0
+
+def summary(trace, args, start=None):
+    '''Peak and RMS values for each axis that moved.'''
+    stats = {}
+    for axis, name in enumerate(trace.names):
+        if not trace.steps[axis]: continue
+        scale = 1.0 / args.steps_per_mm[axis] if axis < len(args.steps_per_mm) else 1.0
+        pos, vel, acc, jerk = profile(trace, axis, args.bin_ns, args.window, scale, start)
+        stats[name] = {
+            'steps': len(trace.steps[axis]),
+            'net': trace.net(axis) * scale,
+            'v_max': max(map(abs, vel)),
+            'a_max': max(map(abs, acc)),
+            'j_max': max(map(abs, jerk)),
+            'a_rms': rms(acc),
+            'j_rms': rms(jerk),
+            'vel': vel
+        }
+    return stats
+
+FIELDS = ('steps', 'net', 'v_max', 'a_max', 'j_max', 'a_rms', 'j_rms')
+
+def print_stats(stats, unit):
+    print(f'{"axis":>4} {"steps":>10} {"net":>12} {"v_max":>12} {"a_max":>12} {"j_max":>14} {"a_rms":>12} {"j_rms":>14}   ({unit})')
+    for name, s in stats.items():
+        print(f'{name:>4} {s["steps"]:>10} {s["net"]:>12.3f} {s["v_max"]:>12.3f} {s["a_max"]:>12.1f} {s["j_max"]:>14.1f} {s["a_rms"]:>12.1f} {s["j_rms"]:>14.1f}')
+
+def cmd_info(args):
+    t = Trace(args.trace)
+    print(f'{args.trace}: {t.count} steps over {(t.end - t.start) / 1e9:.3f} s')
+    for axis, name in enumerate(t.names):
+        print(f'  {name}: {len(t.steps[axis])} steps, net {t.net(axis)}')
+
+def cmd_profile(args):
+    t = Trace(args.trace)
+    stats = summary(t, args)
+    print_stats(stats, 'mm' if args.steps_per_mm else 'steps')
+    if args.csv:
+        names = list(stats)
+        with open(args.csv, 'w') as f:
+            f.write('time,' + ','.join(f'{n}_vel' for n in names) + '\n')
+            for k in range(len(stats[names[0]]['vel']) if names else 0):
+                f.write(f'{k * args.bin_ns / 1e9:.6f},' + ','.join(f'{stats[n]["vel"][k]:.4f}' for n in names) + '\n')
+
+def cmd_compare(args):
+    a, b = Trace(args.trace), Trace(args.other)
+    sa, sb = summary(a, args), summary(b, args)
+    unit = 'mm' if args.steps_per_mm else 'steps'
+    print(f'Duration: {(a.end - a.start) / 1e9:.3f} s vs. {(b.end - b.start) / 1e9:.3f} s')
+    print(f'{"axis":>4} {"field":>6} {args.trace:>14} {args.other:>14} {"diff %":>8}   ({unit})')
+    ok = True
+    for name in sorted(set(sa) | set(sb)):
+        x, y = sa.get(name), sb.get(name)
+        if not x or not y:
+            print(f'{name:>4} moved in only one trace')
+            ok = False
+            continue
+        for field in FIELDS:
+            pct = 100.0 * (y[field] - x[field]) / abs(x[field]) if x[field] else 0.0
+            flag = ''
+            if field == 'net' and abs(y[field] - x[field]) > 1e-9:
+                flag = ' <- position differs'
+                ok = False
+            elif args.tolerance is not None and field.endswith('_max') and abs(pct) > args.tolerance:
+                flag = ' <- over tolerance'
+                ok = False
+            print(f'{name:>4} {field:>6} {x[field]:>14.3f} {y[field]:>14.3f} {pct:>8.2f}{flag}')
+        n = min(len(x['vel']), len(y['vel']))
+        dv = [ x['vel'][k] - y['vel'][k] for k in range(n) ]
+        print(f'{name:>4} velocity RMS difference: {rms(dv):.3f} {unit}/s')
+    sys.exit(0 if ok else 1)
+
+def main():
+    parser = argparse.ArgumentParser(description='Analyze LINUX HAL step traces.')
+    parser.add_argument('--bin', type=float, default=1.0, help='Bin width in ms (default 1)')
+    parser.add_argument('--window', type=int, default=5, help='Bins on each side for derivatives (default 5)')
+    parser.add_argument('--steps-per-mm', help='Comma-separated steps/mm per axis, to report in mm')
+    sub = parser.add_subparsers(dest='command', required=True)
+    p = sub.add_parser('info', help='Step counts per axis')
+    p.add_argument('trace')
+    p = sub.add_parser('profile', help='Velocity, acceleration and jerk per axis')
+    p.add_argument('trace')
+    p.add_argument('--csv', help='Write the velocity profiles to a CSV file')
+    p = sub.add_parser('compare', help='Compare two traces')
+    p.add_argument('trace')
+    p.add_argument('other')
+    p.add_argument('--tolerance', type=float, help='Allowed difference in peak values, in percent')
+    args = parser.parse_args()
+
+    args.bin_ns = int(args.bin * 1e6)
+    args.steps_per_mm = [ float(v) for v in args.steps_per_mm.split(',') ] if args.steps_per_mm else []
+
+    { 'info': cmd_info, 'profile': cmd_profile, 'compare': cmd_compare }[args.command](args)
+
+if __name__ == '__main__':
+    main()